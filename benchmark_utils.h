@@ -7,21 +7,95 @@
 #include <string>
 #include <iomanip>
 #include <fstream>
+#include <sstream>
 #include <algorithm>
 #include <cmath>
+#include <array>
+#include <cstdint>
+#include "perf_counters.h"
 
 using namespace std;
 
+// гистограмма задержек с логарифмическими корзинами (точность ~12%)
+// Каждый поток пишет в свою гистограмму, в конце они сливаются через merge
+class LatencyHistogram {
+private:
+    static constexpr int LINEAR_BUCKETS = 16;   // 0..15 нс - по одной корзине на значение
+    static constexpr int SUB_BUCKETS = 8;       // корзин на каждую степень двойки
+    static constexpr int NUM_BUCKETS = LINEAR_BUCKETS + (64 - 4) * SUB_BUCKETS;
+    
+    array<uint64_t, NUM_BUCKETS> buckets{};
+    uint64_t total = 0;
+    uint64_t max_value = 0;
+    
+    static int bucket_index(uint64_t value) {
+        if (value < LINEAR_BUCKETS) {
+            return static_cast<int>(value);
+        }
+        int exponent = 63 - __builtin_clzll(value);
+        int sub = static_cast<int>((value >> (exponent - 3)) & (SUB_BUCKETS - 1));
+        return LINEAR_BUCKETS + (exponent - 4) * SUB_BUCKETS + sub;
+    }
+    
+    // Верхняя граница значений корзины
+    static uint64_t bucket_upper(int index) {
+        if (index < LINEAR_BUCKETS) {
+            return static_cast<uint64_t>(index);
+        }
+        int exponent = (index - LINEAR_BUCKETS) / SUB_BUCKETS + 4;
+        int sub = (index - LINEAR_BUCKETS) % SUB_BUCKETS;
+        uint64_t width = 1ull << (exponent - 3);
+        return (static_cast<uint64_t>(SUB_BUCKETS + sub) << (exponent - 3)) + width - 1;
+    }
+    
+public:
+    void record(uint64_t nanoseconds) {
+        buckets[bucket_index(nanoseconds)]++;
+        total++;
+        if (nanoseconds > max_value) {
+            max_value = nanoseconds;
+        }
+    }
+    
+    void merge(const LatencyHistogram& other) {
+        for (int i = 0; i < NUM_BUCKETS; ++i) {
+            buckets[i] += other.buckets[i];
+        }
+        total += other.total;
+        max_value = max(max_value, other.max_value);
+    }
+    
+    uint64_t count() const { return total; }
+    uint64_t max_ns() const { return max_value; }
+    
+    // Перцентиль в наносекундах (p от 0 до 100)
+    double percentile(double p) const {
+        if (total == 0) return 0.0;
+        uint64_t rank = static_cast<uint64_t>(ceil(p / 100.0 * total));
+        if (rank == 0) rank = 1;
+        uint64_t seen = 0;
+        for (int i = 0; i < NUM_BUCKETS; ++i) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                return static_cast<double>(min(bucket_upper(i), max_value));
+            }
+        }
+        return static_cast<double>(max_value);
+    }
+};
+
 // класс бенчмарка
 class Benchmark {
 private:
     chrono::high_resolution_clock::time_point start_time;
     string benchmark_name;
     bool verbose;
+    PerfSample perf_start;
     
 public:
     Benchmark(const string& name, bool verbose_mode = true) 
         : benchmark_name(name), verbose(verbose_mode) {
+        perf_start = PerfCounters::snapshot();
         start_time = chrono::high_resolution_clock::now();
     }
     
@@ -48,6 +122,10 @@ public:
     double elapsed_seconds() const {
         return elapsed_microseconds() / 1000000.0;
     }
+    // счетчики perf с момента создания (по всем учтенным потокам)
+    PerfSample perf_counters() const {
+        return PerfCounters::snapshot() - perf_start;
+    }
     
     // вывод результатов
     static void print_results(const vector<pair<string, double>>& results, 
@@ -106,6 +184,162 @@ public:
         file.close();
         cout << "Результаты сохранены в файл: " << filename << endl;
     }
+    // вывод перцентилей задержки захвата
+    static void print_latency(const vector<pair<string, double>>& results,
+                              const vector<LatencyHistogram>& latencies,
+                              const string& title = "Задержка захвата (нс)") {
+        cout << "\n=== " << title << " ===\n";
+        cout << setw(24) << left << "Тест"
+                  << setw(12) << "p50"
+                  << setw(12) << "p99"
+                  << setw(12) << "p99.9"
+                  << setw(12) << "max" << "\n";
+        cout << string(72, '-') << endl;
+        
+        for (size_t i = 0; i < results.size() && i < latencies.size(); ++i) {
+            if (latencies[i].count() == 0) continue;
+            cout << setw(24) << left << results[i].first
+                      << setw(12) << fixed << setprecision(0) << latencies[i].percentile(50)
+                      << setw(12) << latencies[i].percentile(99)
+                      << setw(12) << latencies[i].percentile(99.9)
+                      << setw(12) << static_cast<double>(latencies[i].max_ns()) << endl;
+        }
+        cout << string(72, '=') << "\n" << endl;
+    }
+    // вывод счетчиков perf ("-" - событие недоступно)
+    static void print_perf(const vector<pair<string, double>>& results,
+                           const vector<PerfSample>& perf,
+                           const string& title = "Счетчики производительности") {
+        bool any = false;
+        for (const auto& sample : perf) {
+            any = any || sample.any();
+        }
+        if (!any) {
+            cout << "\nСчетчики perf недоступны (perf_event_open), выводится только время\n";
+            return;
+        }
+        
+        auto cell = [](const PerfSample& sample, int event) {
+            return sample.has(event) ? to_string(sample[event]) : string("-");
+        };
+        auto ipc_cell = [](const PerfSample& sample) {
+            if (sample.ipc() <= 0) return string("-");
+            ostringstream out;
+            out << fixed << setprecision(2) << sample.ipc();
+            return out.str();
+        };
+        
+        cout << "\n=== " << title << " ===\n";
+        cout << setw(24) << left << "Тест"
+                  << setw(14) << "cycles"
+                  << setw(14) << "instr"
+                  << setw(8) << "IPC"
+                  << setw(12) << "cache-miss"
+                  << setw(12) << "LLC-miss"
+                  << setw(12) << "br-miss"
+                  << setw(10) << "ctx-sw"
+                  << setw(10) << "migr" << "\n";
+        cout << string(116, '-') << endl;
+        
+        for (size_t i = 0; i < results.size() && i < perf.size(); ++i) {
+            const PerfSample& sample = perf[i];
+            if (!sample.any()) continue;
+            cout << setw(24) << left << results[i].first
+                      << setw(14) << cell(sample, PERF_CYCLES)
+                      << setw(14) << cell(sample, PERF_INSTRUCTIONS)
+                      << setw(8) << ipc_cell(sample)
+                      << setw(12) << cell(sample, PERF_CACHE_MISSES)
+                      << setw(12) << cell(sample, PERF_LLC_MISSES)
+                      << setw(12) << cell(sample, PERF_BRANCH_MISSES)
+                      << setw(10) << cell(sample, PERF_CONTEXT_SWITCHES)
+                      << setw(10) << cell(sample, PERF_CPU_MIGRATIONS) << endl;
+        }
+        cout << string(116, '=') << "\n" << endl;
+    }
+    // csv с перцентилями задержки (пустые ячейки, если задержки не измерялись)
+    static void save_to_csv(const vector<pair<string, double>>& results,
+                           const vector<LatencyHistogram>& latencies,
+                           const string& filename) {
+        save_to_csv(results, latencies, {}, filename);
+    }
+    // csv с перцентилями задержки и счетчиками perf (пустые ячейки - не измерялось)
+    static void save_to_csv(const vector<pair<string, double>>& results,
+                           const vector<LatencyHistogram>& latencies,
+                           const vector<PerfSample>& perf,
+                           const string& filename) {
+        ofstream file(filename);
+        if (!file.is_open()) {
+            cerr << "Ошибка: не удалось создать файл " << filename << endl;
+            return;
+        }
+        
+        file << "Тест,Время(микросекунды),Время(миллисекунды),Время(секунды),"
+             << "p50(нс),p99(нс),p99.9(нс),max(нс)";
+        if (!perf.empty()) {
+            for (const char* name : PERF_EVENT_NAMES) {
+                file << "," << name;
+            }
+            file << ",ipc";
+        }
+        file << "\n";
+        
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& result = results[i];
+            file << result.first << ","
+                 << result.second << ","
+                 << result.second / 1000.0 << ","
+                 << result.second / 1000000.0 << ",";
+            if (i < latencies.size() && latencies[i].count() > 0) {
+                file << latencies[i].percentile(50) << ","
+                     << latencies[i].percentile(99) << ","
+                     << latencies[i].percentile(99.9) << ","
+                     << latencies[i].max_ns();
+            } else {
+                file << ",,,";
+            }
+            if (!perf.empty()) {
+                PerfSample sample = i < perf.size() ? perf[i] : PerfSample{};
+                for (int e = 0; e < PERF_EVENT_COUNT; ++e) {
+                    file << ",";
+                    if (sample.has(e)) file << sample[e];
+                }
+                file << ",";
+                if (sample.ipc() > 0) file << sample.ipc();
+            }
+            file << "\n";
+        }
+        
+        file.close();
+        cout << "Результаты сохранены в файл: " << filename << endl;
+    }
+    // csv-матрица: строка на тест, столбец на параметр (например, число потоков)
+    static void save_matrix_to_csv(const vector<string>& rows,
+                                   const vector<string>& columns,
+                                   const vector<vector<double>>& values,
+                                   const string& filename) {
+        ofstream file(filename);
+        if (!file.is_open()) {
+            cerr << "Ошибка: не удалось создать файл " << filename << endl;
+            return;
+        }
+        
+        file << "Тест";
+        for (const auto& column : columns) {
+            file << "," << column;
+        }
+        file << "\n";
+        
+        for (size_t r = 0; r < rows.size() && r < values.size(); ++r) {
+            file << rows[r];
+            for (double value : values[r]) {
+                file << "," << value;
+            }
+            file << "\n";
+        }
+        
+        file.close();
+        cout << "Результаты сохранены в файл: " << filename << endl;
+    }
     // вывод статистики
     static void print_statistics(const vector<pair<string, double>>& results) {
         if (results.empty()) return;
@@ -0,0 +1,93 @@
+#ifndef FAST_RANDOM_H
+#define FAST_RANDOM_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+
+using namespace std;
+
+// SplitMix64: засев и расщепление потоков генератора
+class SplitMix64 {
+private:
+    uint64_t state;
+
+public:
+    explicit SplitMix64(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+};
+
+// xoshiro256**: быстрый генератор для нагрузки бенчмарков (не криптостойкий)
+// Подходит под UniformRandomBitGenerator, но обычно хватает uniform()/below()
+class Xoshiro256 {
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256(uint64_t seed = 0) {
+        SplitMix64 sm(seed);
+        for (auto& word : s) {
+            word = sm.next();
+        }
+    }
+
+    // Независимый генератор для потока stream: один seed -> воспроизводимый набор потоков
+    static Xoshiro256 for_thread(uint64_t seed, uint64_t stream) {
+        SplitMix64 sm(seed ^ (stream * 0xD1B54A32D192ED03ull));
+        return Xoshiro256(sm.next());
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return numeric_limits<uint64_t>::max(); }
+
+    result_type operator()() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Число в [0, n) умножением со сдвигом (без деления)
+    uint64_t below(uint64_t n) {
+        return static_cast<uint64_t>((static_cast<unsigned __int128>((*this)()) * n) >> 64);
+    }
+
+    // Целое в [lo, hi]
+    int uniform(int lo, int hi) {
+        return lo + static_cast<int>(below(static_cast<uint64_t>(hi - lo) + 1));
+    }
+
+    // Вещественное в [lo, hi)
+    double uniform_real(double lo, double hi) {
+        return lo + ((*this)() >> 11) * 0x1.0p-53 * (hi - lo);
+    }
+};
+
+// Общий seed бенчмарков: переменная окружения BENCH_SEED или значение по умолчанию.
+// Одинаковый seed дает одинаковую нагрузку, так что прогоны можно сравнивать
+inline uint64_t& benchmark_seed() {
+    static uint64_t seed = []() {
+        const char* env = getenv("BENCH_SEED");
+        return env != nullptr ? strtoull(env, nullptr, 10) : 20240601ull;
+    }();
+    return seed;
+}
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef PARALLEL_REDUCE_H
+#define PARALLEL_REDUCE_H
+
+#include "work_stealing.h"
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+using namespace std;
+
+// Диапазон свертки: элементы [0, size) на num_threads воркерах, куски по grain
+struct ReduceRange {
+    size_t size = 0;
+    int num_threads = 1;
+    size_t grain = 0;     // 0 - WorkStealingScheduler::default_grain
+};
+
+// Аккумулятор воркера на своих кэш-линиях: потоки не пишут в общую линию
+template <typename Acc>
+struct alignas(64) PaddedAccumulator {
+    Acc value;
+};
+
+// Параллельная свертка через WorkStealingScheduler.
+// map(acc, begin, end) добавляет кусок [begin, end) в acc, combine(into, from) сливает два
+// аккумулятора. Внутри куска map работает с локальной копией (компилятор держит ее в регистрах),
+// в слот воркера она записывается один раз на кусок. Слоты сливаются по порядку воркеров.
+// identity - начальное значение каждого слота и результата
+template <typename Acc, typename Map, typename Combine>
+Acc parallel_reduce(const ReduceRange& range, Map&& map, Combine&& combine,
+                    const Acc& identity = Acc{}) {
+    int num_threads = max(1, range.num_threads);
+    size_t grain = range.grain > 0
+        ? range.grain : WorkStealingScheduler::default_grain(range.size, num_threads);
+
+    vector<PaddedAccumulator<Acc>> slots(num_threads, PaddedAccumulator<Acc>{identity});
+    WorkStealingScheduler::instance().parallel_for(
+        range.size, num_threads, grain, [&](int worker, size_t begin, size_t end) {
+            Acc local = slots[worker].value;
+            map(local, begin, end);
+            slots[worker].value = local;
+        });
+
+    Acc result = identity;
+    for (const auto& slot : slots) {
+        combine(result, slot.value);
+    }
+    return result;
+}
+
+#endif
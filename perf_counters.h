@@ -0,0 +1,249 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <array>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <memory>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// Счетчики perf_event_open: отличаем перебрасывание кэш-линий от накладных расходов планировщика
+enum PerfEvent {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_CACHE_MISSES,
+    PERF_LLC_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_CONTEXT_SWITCHES,
+    PERF_CPU_MIGRATIONS,
+    PERF_EVENT_COUNT
+};
+
+constexpr const char* PERF_EVENT_NAMES[PERF_EVENT_COUNT] = {
+    "cycles", "instructions", "cache_misses", "llc_misses",
+    "branch_misses", "context_switches", "cpu_migrations"
+};
+
+// Значения счетчиков; available - битовая маска событий, которые удалось открыть
+struct PerfSample {
+    array<uint64_t, PERF_EVENT_COUNT> values{};
+    unsigned available = 0;
+
+    bool has(int event) const { return (available >> event) & 1u; }
+    bool any() const { return available != 0; }
+    uint64_t operator[](int event) const { return values[event]; }
+
+    // Сумма по потокам: событие есть, если оно есть хотя бы у одного потока
+    PerfSample& operator+=(const PerfSample& other) {
+        for (int e = 0; e < PERF_EVENT_COUNT; ++e) {
+            values[e] += other.values[e];
+        }
+        available |= other.available;
+        return *this;
+    }
+
+    // Разность двух снимков (счетчики только растут)
+    PerfSample operator-(const PerfSample& before) const {
+        PerfSample delta;
+        delta.available = available & before.available;
+        for (int e = 0; e < PERF_EVENT_COUNT; ++e) {
+            delta.values[e] = values[e] >= before.values[e] ? values[e] - before.values[e] : 0;
+        }
+        return delta;
+    }
+
+    // Инструкций за такт (0, если нет одного из счетчиков)
+    double ipc() const {
+        if (!has(PERF_CYCLES) || !has(PERF_INSTRUCTIONS) || values[PERF_CYCLES] == 0) return 0.0;
+        return static_cast<double>(values[PERF_INSTRUCTIONS]) / values[PERF_CYCLES];
+    }
+};
+
+// Счетчики потоков процесса. Каждый поток, работу которого нужно учитывать, вызывает
+// register_current_thread(); snapshot() суммирует счетчики всех зарегистрированных потоков.
+// Аппаратные события открываются одной группой (читаются согласованно), программные -
+// по отдельности. Если perf недоступен (нет прав, виртуалка, не Linux), маска available
+// пустая и в отчетах выводится "-". Отключение: BENCH_PERF=0
+class PerfCounters {
+private:
+#ifdef __linux__
+    struct ThreadCounters {
+        int group_fd = -1;                  // лидер аппаратной группы (cycles)
+        vector<int> group_events;           // события группы в порядке добавления
+        array<int, PERF_EVENT_COUNT> single_fds;
+
+        ThreadCounters() {
+            single_fds.fill(-1);
+
+            static const pair<uint32_t, uint64_t> hardware[] = {
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+                {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL |
+                                     (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                     (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            };
+            for (int e = PERF_CYCLES; e <= PERF_BRANCH_MISSES; ++e) {
+                int fd = open_event(hardware[e].first, hardware[e].second, group_fd);
+                if (fd < 0) {
+                    // Без лидера группы нет смысла открывать остальные аппаратные события
+                    if (e == PERF_CYCLES) break;
+                    continue;
+                }
+                if (group_fd < 0) group_fd = fd; else single_fds[e] = fd;
+                group_events.push_back(e);
+            }
+
+            single_fds[PERF_CONTEXT_SWITCHES] =
+                open_event(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, -1);
+            single_fds[PERF_CPU_MIGRATIONS] =
+                open_event(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS, -1);
+
+            if (group_fd >= 0) {
+                ioctl(group_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                ioctl(group_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+        }
+
+        ~ThreadCounters() {
+            if (group_fd >= 0) close(group_fd);
+            for (int fd : single_fds) {
+                if (fd >= 0) close(fd);
+            }
+        }
+
+        ThreadCounters(const ThreadCounters&) = delete;
+        ThreadCounters& operator=(const ThreadCounters&) = delete;
+
+        // Счетчик только текущего потока на любом CPU. Аппаратные - без ядра и гипервизора
+        // (хватает perf_event_paranoid <= 2); программные считаются в ядре, их не фильтруем
+        static int open_event(uint32_t type, uint64_t config, int group) {
+            bool hardware = type != PERF_TYPE_SOFTWARE;
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = hardware && group < 0 ? 1 : 0;
+            attr.exclude_kernel = hardware ? 1 : 0;
+            attr.exclude_hv = hardware ? 1 : 0;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            if (hardware) {
+                attr.read_format |= PERF_FORMAT_GROUP;
+            }
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+        }
+
+        // Поправка на мультиплексирование: счетчик работал только часть времени
+        static uint64_t scaled(uint64_t value, uint64_t enabled, uint64_t running) {
+            if (running == 0) return 0;
+            if (running >= enabled) return value;
+            return static_cast<uint64_t>(static_cast<double>(value) * enabled / running);
+        }
+
+        PerfSample read_sample() const {
+            PerfSample sample;
+            if (group_fd >= 0) {
+                // nr, time_enabled, time_running, values[nr]
+                uint64_t buffer[3 + PERF_EVENT_COUNT] = {};
+                if (read(group_fd, buffer, sizeof(buffer)) > 0) {
+                    uint64_t count = min<uint64_t>(buffer[0], group_events.size());
+                    for (uint64_t k = 0; k < count; ++k) {
+                        int e = group_events[k];
+                        sample.values[e] = scaled(buffer[3 + k], buffer[1], buffer[2]);
+                        sample.available |= 1u << e;
+                    }
+                }
+            }
+            for (int e : {PERF_CONTEXT_SWITCHES, PERF_CPU_MIGRATIONS}) {
+                if (single_fds[e] < 0) continue;
+                uint64_t buffer[3] = {};
+                if (read(single_fds[e], buffer, sizeof(buffer)) > 0) {
+                    sample.values[e] = scaled(buffer[0], buffer[1], buffer[2]);
+                    sample.available |= 1u << e;
+                }
+            }
+            return sample;
+        }
+    };
+
+    struct Registry {
+        mutex mtx;
+        vector<shared_ptr<ThreadCounters>> threads;
+        PerfSample retired;                 // итог потоков, которые уже завершились
+    };
+
+    // Не разрушается при выходе: воркеры пула снимаются с учета уже после статических объектов
+    static Registry& registry() {
+        static Registry* instance = new Registry;
+        return *instance;
+    }
+
+    // Снимает поток с учета при выходе, сохраняя его итоговые значения
+    struct ThreadHandle {
+        shared_ptr<ThreadCounters> counters;
+
+        ~ThreadHandle() {
+            if (!counters) return;
+            Registry& reg = registry();
+            lock_guard<mutex> lock(reg.mtx);
+            reg.retired += counters->read_sample();
+            reg.threads.erase(remove(reg.threads.begin(), reg.threads.end(), counters),
+                              reg.threads.end());
+        }
+    };
+#endif
+
+public:
+    static bool enabled() {
+        static bool on = []() {
+            const char* env = getenv("BENCH_PERF");
+            return env == nullptr || string(env) != "0";
+        }();
+        return on;
+    }
+
+    // Включает учет текущего потока (повторный вызов ничего не делает)
+    static void register_current_thread() {
+#ifdef __linux__
+        if (!enabled()) return;
+        thread_local ThreadHandle handle;
+        if (handle.counters) return;
+        handle.counters = make_shared<ThreadCounters>();
+        Registry& reg = registry();
+        lock_guard<mutex> lock(reg.mtx);
+        reg.threads.push_back(handle.counters);
+#endif
+    }
+
+    // Суммарные значения по всем зарегистрированным (в том числе завершившимся) потокам
+    static PerfSample snapshot() {
+        PerfSample total;
+#ifdef __linux__
+        if (!enabled()) return total;
+        register_current_thread();
+        Registry& reg = registry();
+        lock_guard<mutex> lock(reg.mtx);
+        total = reg.retired;
+        for (const auto& counters : reg.threads) {
+            total += counters->read_sample();
+        }
+#endif
+        return total;
+    }
+};
+
+#endif
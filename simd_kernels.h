@@ -0,0 +1,260 @@
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <algorithm>
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define SIMD_KERNELS_X86 1
+#endif
+
+using namespace std;
+
+// Векторные ядра фильтра и свертки по столбцам сотрудников (task2).
+// Версия выбирается во время выполнения по возможностям CPU; без AVX2 - скалярный цикл
+enum class SimdLevel {
+    SCALAR,
+    AVX2,
+    AVX512
+};
+
+inline string simd_level_name(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SCALAR: return "scalar";
+        case SimdLevel::AVX2: return "avx2";
+        case SimdLevel::AVX512: return "avx512";
+    }
+    return "scalar";
+}
+
+// Уровни, которые поддерживает этот CPU (по возрастанию)
+inline vector<SimdLevel> supported_simd_levels() {
+    vector<SimdLevel> levels = {SimdLevel::SCALAR};
+#ifdef SIMD_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        levels.push_back(SimdLevel::AVX2);
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        levels.push_back(SimdLevel::AVX512);
+    }
+#endif
+    return levels;
+}
+
+// Текущий уровень: лучший доступный или BENCH_SIMD=scalar|avx2|avx512 (не выше доступного).
+// Как и benchmark_seed(), его можно поменять на время бенчмарка
+inline SimdLevel& simd_level() {
+    static SimdLevel level = []() {
+        vector<SimdLevel> levels = supported_simd_levels();
+        SimdLevel best = levels.back();
+        const char* env = getenv("BENCH_SIMD");
+        if (env == nullptr) return best;
+        for (SimdLevel l : levels) {
+            if (simd_level_name(l) == env) return l;
+        }
+        return best;
+    }();
+    return level;
+}
+
+// Число совпадений и сумма возрастов строк с position_ids[j] == target
+struct AgeSum {
+    long long count = 0;
+    long long sum = 0;
+};
+
+namespace simd_detail {
+
+inline AgeSum count_age_sum_scalar(const int* ids, const int* ages, size_t n, int target) {
+    AgeSum result;
+    for (size_t j = 0; j < n; ++j) {
+        if (ids[j] == target) {
+            result.count++;
+            result.sum += ages[j];
+        }
+    }
+    return result;
+}
+
+inline double max_salary_scalar(const int* ids, const int* ages, const double* salaries,
+                                size_t n, int target, int min_age, int max_age, double best) {
+    for (size_t j = 0; j < n; ++j) {
+        if (ids[j] == target && ages[j] >= min_age && ages[j] <= max_age && salaries[j] > best) {
+            best = salaries[j];
+        }
+    }
+    return best;
+}
+
+// 32-битные суммы по полосам сбрасываем в 64 бита раньше, чем они могут переполниться
+// (при возрасте меньше 32768 хватает 2^16 итераций)
+constexpr size_t FLUSH_ITERATIONS = size_t(1) << 16;
+
+#ifdef SIMD_KERNELS_X86
+
+__attribute__((target("avx2")))
+inline long long horizontal_sum_epi32(__m256i v) {
+    alignas(32) int lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), v);
+    long long sum = 0;
+    for (int lane : lanes) sum += lane;
+    return sum;
+}
+
+__attribute__((target("avx2")))
+inline AgeSum count_age_sum_avx2(const int* ids, const int* ages, size_t n, int target) {
+    AgeSum result;
+    const __m256i target_v = _mm256_set1_epi32(target);
+    size_t j = 0;
+    while (j + 8 <= n) {
+        __m256i sum_v = _mm256_setzero_si256();
+        __m256i count_v = _mm256_setzero_si256();
+        size_t block_end = j + min(n - j, FLUSH_ITERATIONS * 8) / 8 * 8;
+        for (; j < block_end; j += 8) {
+            __m256i id = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ids + j));
+            __m256i age = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ages + j));
+            __m256i match = _mm256_cmpeq_epi32(id, target_v);
+            sum_v = _mm256_add_epi32(sum_v, _mm256_and_si256(match, age));
+            count_v = _mm256_sub_epi32(count_v, match);   // совпадение = -1
+        }
+        result.sum += horizontal_sum_epi32(sum_v);
+        result.count += horizontal_sum_epi32(count_v);
+    }
+    AgeSum tail = count_age_sum_scalar(ids + j, ages + j, n - j, target);
+    result.count += tail.count;
+    result.sum += tail.sum;
+    return result;
+}
+
+// По 4 строки: 32-битная маска возраста и должности расширяется до 64 бит под зарплаты
+__attribute__((target("avx2")))
+inline double max_salary_avx2(const int* ids, const int* ages, const double* salaries,
+                              size_t n, int target, int min_age, int max_age) {
+    const __m128i target_v = _mm_set1_epi32(target);
+    const __m128i below_v = _mm_set1_epi32(min_age - 1);
+    const __m128i above_v = _mm_set1_epi32(max_age + 1);
+    __m256d best0 = _mm256_setzero_pd();
+    __m256d best1 = _mm256_setzero_pd();
+    size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m128i id0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ids + j));
+        __m128i id1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ids + j + 4));
+        __m128i age0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ages + j));
+        __m128i age1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ages + j + 4));
+        __m128i m0 = _mm_and_si128(_mm_cmpeq_epi32(id0, target_v),
+                                   _mm_and_si128(_mm_cmpgt_epi32(age0, below_v),
+                                                 _mm_cmpgt_epi32(above_v, age0)));
+        __m128i m1 = _mm_and_si128(_mm_cmpeq_epi32(id1, target_v),
+                                   _mm_and_si128(_mm_cmpgt_epi32(age1, below_v),
+                                                 _mm_cmpgt_epi32(above_v, age1)));
+        __m256d mask0 = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(m0));
+        __m256d mask1 = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(m1));
+        // Не прошедшие фильтр строки дают 0, а зарплаты положительные
+        best0 = _mm256_max_pd(best0, _mm256_and_pd(mask0, _mm256_loadu_pd(salaries + j)));
+        best1 = _mm256_max_pd(best1, _mm256_and_pd(mask1, _mm256_loadu_pd(salaries + j + 4)));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, _mm256_max_pd(best0, best1));
+    double best = max(max(lanes[0], lanes[1]), max(lanes[2], lanes[3]));
+    return max_salary_scalar(ids + j, ages + j, salaries + j, n - j, target, min_age, max_age, best);
+}
+
+__attribute__((target("avx512f")))
+inline AgeSum count_age_sum_avx512(const int* ids, const int* ages, size_t n, int target) {
+    AgeSum result;
+    const __m512i target_v = _mm512_set1_epi32(target);
+    size_t j = 0;
+    while (j + 16 <= n) {
+        __m512i sum_v = _mm512_setzero_si512();
+        long long count = 0;
+        size_t block_end = j + min(n - j, FLUSH_ITERATIONS * 16) / 16 * 16;
+        for (; j < block_end; j += 16) {
+            __m512i id = _mm512_loadu_si512(ids + j);
+            __m512i age = _mm512_loadu_si512(ages + j);
+            __mmask16 match = _mm512_cmpeq_epi32_mask(id, target_v);
+            sum_v = _mm512_mask_add_epi32(sum_v, match, sum_v, age);
+            count += __builtin_popcount(match);
+        }
+        alignas(64) int lanes[16];
+        _mm512_store_si512(lanes, sum_v);
+        for (int lane : lanes) result.sum += lane;
+        result.count += count;
+    }
+    AgeSum tail = count_age_sum_scalar(ids + j, ages + j, n - j, target);
+    result.count += tail.count;
+    result.sum += tail.sum;
+    return result;
+}
+
+// По 16 строк: маска на 16 полос, младшие 8 бит - первая половина зарплат, старшие - вторая
+__attribute__((target("avx512f")))
+inline double max_salary_avx512(const int* ids, const int* ages, const double* salaries,
+                                size_t n, int target, int min_age, int max_age) {
+    const __m512i target_v = _mm512_set1_epi32(target);
+    const __m512i min_v = _mm512_set1_epi32(min_age);
+    const __m512i max_v = _mm512_set1_epi32(max_age);
+    __m512d best0 = _mm512_setzero_pd();
+    __m512d best1 = _mm512_setzero_pd();
+    size_t j = 0;
+    for (; j + 16 <= n; j += 16) {
+        __m512i id = _mm512_loadu_si512(ids + j);
+        __m512i age = _mm512_loadu_si512(ages + j);
+        __mmask16 match = _mm512_cmpeq_epi32_mask(id, target_v);
+        match = _mm512_mask_cmpge_epi32_mask(match, age, min_v);
+        match = _mm512_mask_cmple_epi32_mask(match, age, max_v);
+        best0 = _mm512_mask_max_pd(best0, static_cast<__mmask8>(match), best0,
+                                   _mm512_loadu_pd(salaries + j));
+        best1 = _mm512_mask_max_pd(best1, static_cast<__mmask8>(match >> 8), best1,
+                                   _mm512_loadu_pd(salaries + j + 8));
+    }
+    alignas(64) double lanes[16];
+    _mm512_store_pd(lanes, best0);
+    _mm512_store_pd(lanes + 8, best1);
+    double best = *max_element(lanes, lanes + 16);
+    return max_salary_scalar(ids + j, ages + j, salaries + j, n - j, target, min_age, max_age, best);
+}
+
+#endif
+
+} // namespace simd_detail
+
+// Сколько строк с должностью target и сумма их возрастов
+inline AgeSum count_age_sum(const int* ids, const int* ages, size_t n, int target,
+                            SimdLevel level = simd_level()) {
+#ifdef SIMD_KERNELS_X86
+    switch (level) {
+        case SimdLevel::AVX512: return simd_detail::count_age_sum_avx512(ids, ages, n, target);
+        case SimdLevel::AVX2: return simd_detail::count_age_sum_avx2(ids, ages, n, target);
+        case SimdLevel::SCALAR: break;
+    }
+#else
+    (void)level;
+#endif
+    return simd_detail::count_age_sum_scalar(ids, ages, n, target);
+}
+
+// Максимальная зарплата строк с должностью target и возрастом в [min_age, max_age]
+// (0, если таких нет - как и в обычном запросе)
+inline double max_salary_in_age_range(const int* ids, const int* ages, const double* salaries,
+                                      size_t n, int target, int min_age, int max_age,
+                                      SimdLevel level = simd_level()) {
+#ifdef SIMD_KERNELS_X86
+    switch (level) {
+        case SimdLevel::AVX512:
+            return simd_detail::max_salary_avx512(ids, ages, salaries, n, target, min_age, max_age);
+        case SimdLevel::AVX2:
+            return simd_detail::max_salary_avx2(ids, ages, salaries, n, target, min_age, max_age);
+        case SimdLevel::SCALAR: break;
+    }
+#else
+    (void)level;
+#endif
+    return simd_detail::max_salary_scalar(ids, ages, salaries, n, target, min_age, max_age, 0.0);
+}
+
+#endif
@@ -1,13 +1,27 @@
 #include "task1_race.h"
 #include "benchmark_utils.h"
+#include "fast_random.h"
+#include "worker_pool.h"
 #include <iostream>
 #include <thread>
 #include <mutex>
 #include <atomic>
 #include <vector>
-#include <random>
 #include <condition_variable>
 #include <sstream>
+#include <memory>
+#include <shared_mutex>
+#include <queue>
+#include <functional>
+#include <semaphore>
+#include <barrier>
+#include <latch>
+#ifdef __linux__
+#include <sched.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 using namespace std::chrono_literals;
@@ -48,6 +62,338 @@ public:
     }
 };
 
+// Размер кэш-линии: очереди блокировок разносят по линиям то, на чем крутятся ожидающие
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+// Подсказка процессору внутри цикла ожидания
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+// Ожидание на своей кэш-линии: сначала pause, после длинной серии уступаем процессор,
+// чтобы очередь не вставала, когда следующий в ней поток вытеснен планировщиком
+template <typename Pred>
+inline void spin_until(Pred ready) {
+    for (unsigned spins = 0; !ready(); ++spins) {
+        if (spins < 256) {
+            cpu_relax();
+        } else {
+            this_thread::yield();
+        }
+    }
+}
+
+// Ожидание на слове в ядре: на Linux через futex, иначе через atomic::wait из C++20
+static_assert(sizeof(atomic<int>) == sizeof(int), "futex требует 32-битного слова");
+
+inline void futex_wait(atomic<int>& word, int expected) {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAIT_PRIVATE, expected,
+            nullptr, nullptr, 0);
+#else
+    word.wait(expected, memory_order_relaxed);
+#endif
+}
+
+inline void futex_wake(atomic<int>& word, int count) {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAKE_PRIVATE, count,
+            nullptr, nullptr, 0);
+#else
+    if (count == 1) {
+        word.notify_one();
+    } else {
+        word.notify_all();
+    }
+#endif
+}
+
+// Флаг на отдельной кэш-линии (чтобы соседние флаги не делили линию)
+struct alignas(CACHE_LINE_SIZE) PaddedFlag {
+    atomic<unsigned> value{0};
+};
+
+// Счетчики на отдельных кэш-линиях для шардированной агрегации
+struct alignas(CACHE_LINE_SIZE) PaddedCounter {
+    long long value = 0;
+};
+
+struct alignas(CACHE_LINE_SIZE) PaddedAtomicCounter {
+    atomic<long long> value{0};
+};
+
+// Полосатый счетчик: поток прибавляет к своей полосе, чтение суммирует все полосы
+class StripedCounter {
+private:
+    vector<PaddedAtomicCounter> stripes;
+    
+public:
+    StripedCounter(int num_stripes) : stripes(max(1, num_stripes)) {}
+    
+    void add(int stripe, long long delta) {
+        stripes[stripe % stripes.size()].value.fetch_add(delta, memory_order_relaxed);
+    }
+    
+    long long sum() const {
+        long long total = 0;
+        for (const auto& s : stripes) {
+            total += s.value.load(memory_order_relaxed);
+        }
+        return total;
+    }
+};
+
+// ticket lock (FIFO по номерам билетов)
+// Все ждущие читают now_serving, поэтому ждем пропорционально своей позиции в очереди,
+// а счетчики разнесены по разным кэш-линиям, чтобы захват билета не сбивал ожидающих
+class TicketLock {
+private:
+    alignas(CACHE_LINE_SIZE) atomic<unsigned> next_ticket{0};
+    alignas(CACHE_LINE_SIZE) atomic<unsigned> now_serving{0};
+    
+public:
+    void lock() {
+        unsigned my_ticket = next_ticket.fetch_add(1, memory_order_relaxed);
+        for (unsigned rounds = 0; ; ++rounds) {
+            unsigned serving = now_serving.load(memory_order_acquire);
+            if (serving == my_ticket) {
+                return;
+            }
+            if (rounds < 8) {
+                for (unsigned k = (my_ticket - serving) * 32; k > 0; --k) {
+                    cpu_relax();
+                }
+            } else {
+                this_thread::yield();
+            }
+        }
+    }
+    
+    void unlock() {
+        now_serving.store(now_serving.load(memory_order_relaxed) + 1, memory_order_release);
+    }
+    
+    // Есть ли очередь за текущим владельцем (вызывает владелец)
+    bool has_waiters() const {
+        return next_ticket.load(memory_order_relaxed) - now_serving.load(memory_order_relaxed) > 1;
+    }
+};
+
+// MCS lock
+// Каждый ждущий крутится на флаге в собственном узле очереди.
+// Узел берется из thread_local, поэтому поток не должен держать два MCSLock одновременно
+class MCSLock {
+private:
+    struct alignas(CACHE_LINE_SIZE) QNode {
+        atomic<QNode*> next{nullptr};
+        atomic<bool> locked{false};
+    };
+    
+    alignas(CACHE_LINE_SIZE) atomic<QNode*> tail{nullptr};
+    
+    static QNode& local_node() {
+        static thread_local QNode node;
+        return node;
+    }
+    
+public:
+    void lock() {
+        QNode& node = local_node();
+        node.next.store(nullptr, memory_order_relaxed);
+        node.locked.store(true, memory_order_relaxed);
+        
+        QNode* pred = tail.exchange(&node, memory_order_acq_rel);
+        if (pred != nullptr) {
+            pred->next.store(&node, memory_order_release);
+            spin_until([&]() { return !node.locked.load(memory_order_acquire); });
+        }
+    }
+    
+    void unlock() {
+        QNode& node = local_node();
+        QNode* succ = node.next.load(memory_order_acquire);
+        if (succ == nullptr) {
+            QNode* expected = &node;
+            if (tail.compare_exchange_strong(expected, nullptr,
+                                             memory_order_release, memory_order_relaxed)) {
+                return;
+            }
+            // Преемник уже встал в очередь, но еще не успел прописать себя
+            spin_until([&]() { return (succ = node.next.load(memory_order_acquire)) != nullptr; });
+        }
+        succ->locked.store(false, memory_order_release);
+    }
+};
+
+// CLH lock
+// Ждущий крутится на узле предшественника, а после освобождения забирает его себе.
+// Узел хвоста принадлежит блокировке, остальные узлы - потокам (тоже один CLHLock на поток)
+class CLHLock {
+private:
+    struct alignas(CACHE_LINE_SIZE) QNode {
+        atomic<bool> locked{false};
+    };
+    
+    struct ThreadNodes {
+        unique_ptr<QNode> mine = make_unique<QNode>();
+        QNode* pred = nullptr;
+    };
+    
+    alignas(CACHE_LINE_SIZE) atomic<QNode*> tail;
+    
+    static ThreadNodes& local_nodes() {
+        static thread_local ThreadNodes nodes;
+        return nodes;
+    }
+    
+public:
+    CLHLock() : tail(new QNode) {}
+    ~CLHLock() { delete tail.load(); }
+    
+    CLHLock(const CLHLock&) = delete;
+    CLHLock& operator=(const CLHLock&) = delete;
+    
+    void lock() {
+        ThreadNodes& nodes = local_nodes();
+        nodes.mine->locked.store(true, memory_order_relaxed);
+        nodes.pred = tail.exchange(nodes.mine.get(), memory_order_acq_rel);
+        spin_until([&]() { return !nodes.pred->locked.load(memory_order_acquire); });
+    }
+    
+    void unlock() {
+        ThreadNodes& nodes = local_nodes();
+        QNode* released = nodes.mine.release();
+        released->locked.store(false, memory_order_release);
+        // Свой узел остается в очереди, взамен берем узел предшественника
+        nodes.mine.reset(nodes.pred);
+        nodes.pred = nullptr;
+    }
+};
+
+// когортная блокировка (lock cohorting) для NUMA
+// Глобальный ticket lock и локальный ticket lock на каждый узел. Освобождая, владелец
+// передает глобальную блокировку ждущему соседу по узлу, но не больше max_batch раз подряд,
+// чтобы другие узлы не голодали. Ticket lock не привязан к потоку, поэтому глобальную
+// блокировку может отпустить не тот поток, что ее взял.
+// simulated_nodes > 0: узел = номер воркера пула % simulated_nodes (проверка на одноузловой машине)
+class CohortLock {
+private:
+    struct alignas(CACHE_LINE_SIZE) NodeLock {
+        TicketLock local;
+        bool global_owned = false;   // под local: глобальная передана вместе с локальной
+        int batch = 0;               // под local: сколько раз подряд передали внутри узла
+    };
+    
+    TicketLock global;
+    vector<NodeLock> nodes;
+    int simulated_nodes;
+    int max_batch;
+    int owner_node = 0;              // под блокировкой
+    
+    int current_node() const {
+        if (simulated_nodes > 0) {
+            int worker = WorkerPool::current_worker();
+            return worker < 0 ? 0 : worker % simulated_nodes;
+        }
+        return CpuTopology::instance().current_node();
+    }
+    
+public:
+    CohortLock(int simulated = 0, int batch_limit = COHORT_DEFAULT_BATCH)
+        : nodes(simulated > 0 ? simulated : CpuTopology::instance().num_nodes()),
+          simulated_nodes(simulated), max_batch(batch_limit) {}
+    
+    void lock() {
+        int node = current_node();
+        NodeLock& cohort = nodes[node];
+        cohort.local.lock();
+        if (!cohort.global_owned) {
+            global.lock();
+        }
+        owner_node = node;
+    }
+    
+    void unlock() {
+        NodeLock& cohort = nodes[owner_node];
+        if (cohort.local.has_waiters() && cohort.batch < max_batch) {
+            // Передача внутри узла: глобальная остается за когортой
+            cohort.batch++;
+            cohort.global_owned = true;
+        } else {
+            cohort.batch = 0;
+            cohort.global_owned = false;
+            global.unlock();
+        }
+        cohort.local.unlock();
+    }
+};
+
+// адаптивный мьютекс: ограниченное число попыток в спине, затем сон на futex
+// Состояния: 0 - свободен, 1 - захвачен, 2 - захвачен и есть спящие
+class AdaptiveMutex {
+private:
+    atomic<int> state{0};
+    int spin_limit;
+    
+public:
+    explicit AdaptiveMutex(int spins = ADAPTIVE_DEFAULT_SPINS) : spin_limit(spins) {}
+    
+    void lock() {
+        // Быстрый путь: короткое удержание успевает освободиться, пока мы крутимся
+        for (int i = 0; i < spin_limit; ++i) {
+            int expected = 0;
+            if (state.load(memory_order_relaxed) == 0 &&
+                state.compare_exchange_weak(expected, 1, memory_order_acquire,
+                                            memory_order_relaxed)) {
+                return;
+            }
+            cpu_relax();
+        }
+        
+        // Медленный путь: помечаем, что есть спящие, и паркуемся в ядре
+        int c = state.exchange(2, memory_order_acquire);
+        while (c != 0) {
+            futex_wait(state, 2);
+            c = state.exchange(2, memory_order_acquire);
+        }
+    }
+    
+    void unlock() {
+        if (state.exchange(0, memory_order_release) == 2) {
+            futex_wake(state, 1);
+        }
+    }
+};
+
+// мьютекс на std::atomic<int>::wait/notify_one (C++20) - та же схема состояний, что
+// у AdaptiveMutex без спина, но парковка через стандартную библиотеку вместо futex
+class AtomicWaitLock {
+private:
+    atomic<int> state{0};  // 0 - свободен, 1 - захвачен, 2 - захвачен и есть ждущие
+    
+public:
+    void lock() {
+        int expected = 0;
+        if (state.compare_exchange_strong(expected, 1, memory_order_acquire,
+                                          memory_order_relaxed)) {
+            return;
+        }
+        while (state.exchange(2, memory_order_acquire) != 0) {
+            state.wait(2, memory_order_relaxed);
+        }
+    }
+    
+    void unlock() {
+        if (state.exchange(0, memory_order_release) == 2) {
+            state.notify_one();
+        }
+    }
+};
+
 // monitor
 class Monitor {
 private:
@@ -92,281 +438,1644 @@ public:
     }
 };
 
-// barrier
-class Barrier {
+// семафор с быстрым путем без блокировок
+// Свободный семафор берется одним CAS на счетчике, в futex уходим только при нулевом счетчике
+class FastSemaphore {
+private:
+    atomic<int> count;
+    atomic<int> waiters{0};
+    
+public:
+    FastSemaphore(int initial = 1) : count(initial) {}
+    
+    void acquire() {
+        int c = count.load(memory_order_relaxed);
+        while (true) {
+            if (c > 0) {
+                if (count.compare_exchange_weak(c, c - 1, memory_order_acquire,
+                                                memory_order_relaxed)) {
+                    return;
+                }
+                continue;
+            }
+            // Сначала объявляем себя ждущим, потом засыпаем, только если счетчик все еще 0
+            waiters.fetch_add(1, memory_order_seq_cst);
+            futex_wait(count, 0);
+            waiters.fetch_sub(1, memory_order_relaxed);
+            c = count.load(memory_order_relaxed);
+        }
+    }
+    
+    void release() {
+        count.fetch_add(1, memory_order_seq_cst);
+        if (waiters.load(memory_order_seq_cst) > 0) {
+            futex_wake(count, 1);
+        }
+    }
+};
+
+// RW-блокировка с приоритетом писателя
+// Пока писатель ждет, новые читатели не входят, поэтому писатели не голодают
+class WriterPreferringRWLock {
 private:
     mutex mtx;
-    condition_variable cv;
-    int count;
-    int total;
-    int generation = 0;
+    condition_variable readers_cv;
+    condition_variable writers_cv;
+    int active_readers = 0;
+    int waiting_writers = 0;
+    bool writer_active = false;
     
 public:
-    Barrier(int n) : count(n), total(n) {}
+    void lock_shared() {
+        unique_lock<mutex> lock(mtx);
+        readers_cv.wait(lock, [this]() { return !writer_active && waiting_writers == 0; });
+        active_readers++;
+    }
     
-    void arrive_and_wait() {
+    void unlock_shared() {
+        lock_guard<mutex> lock(mtx);
+        if (--active_readers == 0 && waiting_writers > 0) {
+            writers_cv.notify_one();
+        }
+    }
+    
+    void lock() {
         unique_lock<mutex> lock(mtx);
-        int gen = generation;
-        
-        if (--count == 0) {
-            generation++;
-            count = total;
-            cv.notify_all();
+        waiting_writers++;
+        writers_cv.wait(lock, [this]() { return !writer_active && active_readers == 0; });
+        waiting_writers--;
+        writer_active = true;
+    }
+    
+    void unlock() {
+        lock_guard<mutex> lock(mtx);
+        writer_active = false;
+        if (waiting_writers > 0) {
+            writers_cv.notify_one();
         } else {
-            cv.wait(lock, [this, gen]() { return gen != generation; });
+            readers_cv.notify_all();
         }
     }
 };
 
-// Тест mutex
-void test_mutex(int num_threads, int iterations) {
-    mutex mtx;
-    vector<thread> threads;
-    atomic<int> counter{0};
-    atomic<int> progress{0};
+// big-reader RW-блокировка: счетчик читателей на каждое ядро
+// Читатель трогает только счетчик своего ядра, писатель поднимает флаг и ждет обнуления всех счетчиков.
+// Слот закрепляется за потоком при первом захвате (по ядру, на котором он тогда работал)
+class BigReaderRWLock {
+private:
+    vector<PaddedFlag> readers;
+    alignas(CACHE_LINE_SIZE) atomic<bool> writer{false};
     
-    for (int i = 0; i < num_threads; ++i) {
-        threads.emplace_back([&, i]() {
-            random_device rd;
-            mt19937 gen(rd());
-            uniform_int_distribution<> dis(33, 126); // Печатные ASCII символы
-           
-            for (int j = 0; j < iterations; ++j) {
-                lock_guard<mutex> lock(mtx);
-                char c = static_cast<char>(dis(gen));
-                int value = static_cast<int>(c) * (j % 256);
-                counter += value % 256;
-                progress++;
+    int my_slot() {
+        static thread_local int slot = -1;
+        if (slot < 0) {
+#ifdef __linux__
+            int cpu = sched_getcpu();
+#else
+            int cpu = static_cast<int>(hash<thread::id>{}(this_thread::get_id()));
+#endif
+            slot = cpu < 0 ? 0 : cpu;
+        }
+        return slot % static_cast<int>(readers.size());
+    }
+    
+public:
+    BigReaderRWLock() : readers(max(1u, thread::hardware_concurrency())) {}
+    
+    void lock_shared() {
+        auto& mine = readers[my_slot()].value;
+        while (true) {
+            mine.fetch_add(1, memory_order_seq_cst);
+            if (!writer.load(memory_order_seq_cst)) {
+                return;
             }
+            // Писатель активен или ждет: отступаем, чтобы он мог дождаться нуля
+            mine.fetch_sub(1, memory_order_release);
+            spin_until([this]() { return !writer.load(memory_order_acquire); });
+        }
+    }
+    
+    void unlock_shared() {
+        readers[my_slot()].value.fetch_sub(1, memory_order_release);
+    }
+    
+    void lock() {
+        bool expected = false;
+        spin_until([&]() {
+            expected = false;
+            return writer.compare_exchange_weak(expected, true, memory_order_seq_cst);
         });
+        // Парный к fetch_add/load читателя: без барьера acquire-чтение слота может увидеть
+        // старый 0, пока читатель видит writer == false
+        atomic_thread_fence(memory_order_seq_cst);
+        for (auto& slot : readers) {
+            spin_until([&]() { return slot.value.load(memory_order_acquire) == 0; });
+        }
     }
     
-    for (auto& t : threads) {
-        t.join();
+    void unlock() {
+        writer.store(false, memory_order_release);
     }
+};
+
+// seqlock: писатель делает счетчик нечетным на время записи, читатель копирует данные
+// и повторяет чтение, если счетчик был нечетным или изменился. Читатели ничего не пишут,
+// поэтому данные под seqlock должны читаться атомарно (relaxed), а копия - проверяться
+class SeqLock {
+private:
+    alignas(CACHE_LINE_SIZE) atomic<unsigned> sequence{0};
+    mutex writer_mutex;  // писатели между собой
     
-    if (num_threads * iterations < 1000) {
-        cout << "  [Mutex] Завершено операций: " << progress.load() 
-                  << ", итоговое значение: " << counter.load() << endl;
+public:
+    unsigned read_begin() const {
+        unsigned seq;
+        while ((seq = sequence.load(memory_order_acquire)) & 1u) {
+            cpu_relax();
+        }
+        return seq;
     }
-}
+    
+    // true - во время чтения была запись, копию нужно выбросить
+    bool read_retry(unsigned seq) const {
+        atomic_thread_fence(memory_order_acquire);
+        return sequence.load(memory_order_relaxed) != seq;
+    }
+    
+    void write_lock() {
+        writer_mutex.lock();
+        sequence.store(sequence.load(memory_order_relaxed) + 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+    }
+    
+    void write_unlock() {
+        sequence.store(sequence.load(memory_order_relaxed) + 1, memory_order_release);
+        writer_mutex.unlock();
+    }
+};
 
-// Тест semaphore
-void test_semaphore(int num_threads, int iterations) {
-    Semaphore semaphore(1);
-    vector<thread> threads;
-    atomic<int> counter{0};
-    atomic<int> progress{0};
+// RCU на эпохах: данные доступны только через указатель. Писатель публикует новую копию,
+// продвигает эпоху и ждет, пока все читатели, вошедшие до этого, выйдут; затем удаляет старую.
+// Читатель пишет только в свой слот на отдельной кэш-линии, общие линии не трогает
+template <typename T>
+class EpochRcu {
+private:
+    alignas(CACHE_LINE_SIZE) atomic<T*> current;
+    alignas(CACHE_LINE_SIZE) atomic<long long> epoch{1};
+    vector<PaddedAtomicCounter> reader_epochs;  // 0 - читатель вне критической секции
+    mutex writer_mutex;
     
-    for (int i = 0; i < num_threads; ++i) {
-        threads.emplace_back([&, i]() {
-            random_device rd;
-            mt19937 gen(rd());
-            uniform_int_distribution<> dis(33, 126);
-            
-            for (int j = 0; j < iterations; ++j) {
-                semaphore.acquire();
-                char c = static_cast<char>(dis(gen));
-                int value = static_cast<int>(c) * (j % 256);
-                counter += value % 256;
-                progress++;
-                semaphore.release();
+public:
+    EpochRcu(int max_readers, const T& initial)
+        : current(new T(initial)), reader_epochs(max(1, max_readers)) {}
+    
+    ~EpochRcu() { delete current.load(); }
+    
+    // Указатель действителен до read_unlock того же читателя
+    const T* read_lock(int reader) {
+        auto& slot = reader_epochs[reader].value;
+        slot.store(epoch.load(memory_order_acquire), memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        return current.load(memory_order_acquire);
+    }
+    
+    void read_unlock(int reader) {
+        reader_epochs[reader].value.store(0, memory_order_release);
+    }
+    
+    // Копирование с изменением: modify(T&) правит новую копию до публикации
+    template <typename Modify>
+    void update(Modify modify) {
+        lock_guard<mutex> lock(writer_mutex);
+        T* old = current.load(memory_order_relaxed);
+        T* fresh = new T(*old);
+        modify(*fresh);
+        current.store(fresh, memory_order_release);
+        synchronize();
+        delete old;
+    }
+    
+    // Ждем читателей, которые могли увидеть старый указатель (вошли в эпоху < target)
+    void synchronize() {
+        long long target = epoch.fetch_add(1, memory_order_seq_cst) + 1;
+        atomic_thread_fence(memory_order_seq_cst);
+        for (auto& slot : reader_epochs) {
+            spin_until([&]() {
+                long long seen = slot.value.load(memory_order_acquire);
+                return seen == 0 || seen >= target;
+            });
+        }
+    }
+};
+
+// flat combining: поток публикует операцию в свой слот, а захвативший блокировку (комбайнер)
+// выполняет все опубликованные операции пачкой. Общие данные трогает только комбайнер,
+// поэтому они не прыгают между ядрами, а блокировка передается раз на пачку, а не на операцию
+class FlatCombiner {
+private:
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        atomic<bool> pending{false};
+        void (*run)(void*) = nullptr;
+        void* operation = nullptr;
+    };
+    
+    static constexpr int COMBINE_PASSES = 3;  // проходов по слотам за один захват
+    
+    alignas(CACHE_LINE_SIZE) atomic<bool> locked{false};
+    vector<Slot> slots;
+    
+    bool try_lock() {
+        return !locked.load(memory_order_relaxed) &&
+               !locked.exchange(true, memory_order_acquire);
+    }
+    
+    void combine() {
+        for (int pass = 0; pass < COMBINE_PASSES; ++pass) {
+            bool found = false;
+            for (auto& slot : slots) {
+                if (slot.pending.load(memory_order_acquire)) {
+                    slot.run(slot.operation);
+                    slot.pending.store(false, memory_order_release);
+                    found = true;
+                }
             }
-        });
+            if (!found) break;
+        }
+    }
+    
+public:
+    explicit FlatCombiner(int max_threads) : slots(max(1, max_threads)) {}
+    
+    // Выполняет op() под взаимным исключением: сам или руками текущего комбайнера.
+    // thread_id - номер слота, у каждого потока свой
+    template <typename Operation>
+    void execute(int thread_id, Operation& op) {
+        Slot& slot = slots[thread_id];
+        slot.run = [](void* p) { (*static_cast<Operation*>(p))(); };
+        slot.operation = &op;
+        slot.pending.store(true, memory_order_release);
+        
+        for (unsigned spins = 0; ; ++spins) {
+            if (!slot.pending.load(memory_order_acquire)) {
+                return;
+            }
+            if (try_lock()) {
+                combine();
+                locked.store(false, memory_order_release);
+                // Свой запрос комбайнер выполнил в первом же проходе
+                return;
+            }
+            if (spins < 256) cpu_relax(); else this_thread::yield();
+        }
+    }
+};
+
+// ограниченная lock-free MPMC очередь (кольцевой буфер Вьюкова)
+// У каждой ячейки свой номер последовательности: производитель ждет sequence == pos,
+// потребитель - sequence == pos + 1, поэтому обе стороны работают одним CAS по своему индексу
+template <typename T>
+class MPMCQueue {
+private:
+    struct alignas(CACHE_LINE_SIZE) Cell {
+        atomic<size_t> sequence{0};
+        T data{};
+    };
+    
+    vector<Cell> buffer;
+    size_t mask;
+    alignas(CACHE_LINE_SIZE) atomic<size_t> enqueue_pos{0};
+    alignas(CACHE_LINE_SIZE) atomic<size_t> dequeue_pos{0};
+    
+    static size_t round_up_pow2(size_t n) {
+        size_t capacity = 2;
+        while (capacity < n) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+    
+public:
+    explicit MPMCQueue(size_t capacity)
+        : buffer(round_up_pow2(capacity)), mask(buffer.size() - 1) {
+        for (size_t i = 0; i < buffer.size(); ++i) {
+            buffer[i].sequence.store(i, memory_order_relaxed);
+        }
+    }
+    
+    bool try_push(const T& value) {
+        size_t pos = enqueue_pos.load(memory_order_relaxed);
+        while (true) {
+            Cell& cell = buffer[pos & mask];
+            size_t seq = cell.sequence.load(memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    cell.data = value;
+                    cell.sequence.store(pos + 1, memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // очередь полна
+            } else {
+                pos = enqueue_pos.load(memory_order_relaxed);
+            }
+        }
     }
     
-    for (auto& t : threads) {
-        t.join();
+    bool try_pop(T& value) {
+        size_t pos = dequeue_pos.load(memory_order_relaxed);
+        while (true) {
+            Cell& cell = buffer[pos & mask];
+            size_t seq = cell.sequence.load(memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    value = cell.data;
+                    cell.sequence.store(pos + mask + 1, memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // очередь пуста
+            } else {
+                pos = dequeue_pos.load(memory_order_relaxed);
+            }
+        }
+    }
+};
+
+// ограниченная очередь на std::mutex + std::queue (базовая линия для MPMCQueue)
+template <typename T>
+class LockedQueue {
+private:
+    mutex mtx;
+    queue<T> items;
+    size_t capacity;
+    
+public:
+    explicit LockedQueue(size_t cap) : capacity(cap) {}
+    
+    bool try_push(const T& value) {
+        lock_guard<mutex> lock(mtx);
+        if (items.size() >= capacity) {
+            return false;
+        }
+        items.push(value);
+        return true;
+    }
+    
+    bool try_pop(T& value) {
+        lock_guard<mutex> lock(mtx);
+        if (items.empty()) {
+            return false;
+        }
+        value = items.front();
+        items.pop();
+        return true;
+    }
+};
+
+// barrier
+class Barrier {
+private:
+    mutex mtx;
+    condition_variable cv;
+    int count;
+    int total;
+    int generation = 0;
+    
+public:
+    Barrier(int n) : count(n), total(n) {}
+    
+    void arrive_and_wait() {
+        unique_lock<mutex> lock(mtx);
+        int gen = generation;
+        
+        if (--count == 0) {
+            generation++;
+            count = total;
+            cv.notify_all();
+        } else {
+            cv.wait(lock, [this, gen]() { return gen != generation; });
+        }
+    }
+    
+    void arrive_and_wait(int /*thread_id*/) {
+        arrive_and_wait();
+    }
+};
+
+// централизованный барьер с обращением смысла (sense-reversing)
+// Последний пришедший сбрасывает счетчик и переворачивает общий флаг, остальные крутятся на нем
+class SenseBarrier {
+private:
+    alignas(CACHE_LINE_SIZE) atomic<int> count;
+    alignas(CACHE_LINE_SIZE) atomic<bool> sense{false};
+    int total;
+    vector<PaddedFlag> local_sense;
+    
+public:
+    SenseBarrier(int n) : count(n), total(n), local_sense(n) {}
+    
+    void arrive_and_wait(int thread_id) {
+        bool my_sense = local_sense[thread_id].value.load(memory_order_relaxed) == 0;
+        local_sense[thread_id].value.store(my_sense ? 1 : 0, memory_order_relaxed);
+        
+        if (count.fetch_sub(1, memory_order_acq_rel) == 1) {
+            count.store(total, memory_order_relaxed);
+            sense.store(my_sense, memory_order_release);
+        } else {
+            spin_until([&]() { return sense.load(memory_order_acquire) == my_sense; });
+        }
+    }
+};
+
+// барьер на комбинирующем дереве
+// Потоки делятся на группы по RADIX, последний в группе поднимается к родителю;
+// освобождение идет сверху вниз, каждая группа крутится на флаге своего узла
+class TreeBarrier {
+private:
+    static constexpr int RADIX = 4;
+    
+    struct alignas(CACHE_LINE_SIZE) Node {
+        atomic<int> count{0};
+        atomic<bool> sense{false};
+        int size = 0;
+        Node* parent = nullptr;
+    };
+    
+    vector<unique_ptr<Node>> nodes;
+    vector<Node*> leaves;
+    vector<PaddedFlag> local_sense;
+    
+    void arrive(Node* node, bool my_sense) {
+        if (node->count.fetch_sub(1, memory_order_acq_rel) == 1) {
+            if (node->parent != nullptr) {
+                arrive(node->parent, my_sense);
+            }
+            node->count.store(node->size, memory_order_relaxed);
+            node->sense.store(my_sense, memory_order_release);
+        } else {
+            spin_until([&]() { return node->sense.load(memory_order_acquire) == my_sense; });
+        }
+    }
+    
+public:
+    TreeBarrier(int n) : local_sense(n) {
+        // Листья: по RADIX потоков на узел
+        vector<Node*> level;
+        for (int i = 0; i < n; i += RADIX) {
+            nodes.push_back(make_unique<Node>());
+            nodes.back()->size = min(RADIX, n - i);
+            level.push_back(nodes.back().get());
+        }
+        for (int i = 0; i < n; ++i) {
+            leaves.push_back(level[i / RADIX]);
+        }
+        
+        // Строим уровни вверх, пока не останется один корень
+        while (level.size() > 1) {
+            vector<Node*> upper;
+            for (size_t i = 0; i < level.size(); i += RADIX) {
+                nodes.push_back(make_unique<Node>());
+                Node* parent = nodes.back().get();
+                parent->size = static_cast<int>(min<size_t>(RADIX, level.size() - i));
+                for (size_t k = i; k < i + parent->size; ++k) {
+                    level[k]->parent = parent;
+                }
+                upper.push_back(parent);
+            }
+            level = upper;
+        }
+        
+        for (auto& node : nodes) {
+            node->count.store(node->size, memory_order_relaxed);
+        }
+    }
+    
+    void arrive_and_wait(int thread_id) {
+        bool my_sense = local_sense[thread_id].value.load(memory_order_relaxed) == 0;
+        local_sense[thread_id].value.store(my_sense ? 1 : 0, memory_order_relaxed);
+        arrive(leaves[thread_id], my_sense);
+    }
+};
+
+// диссеминационный барьер
+// За ceil(log2 n) раундов поток i сигналит потоку (i + 2^r) % n и ждет сигнала от (i - 2^r) % n.
+// Флаги - монотонные счетчики эпох, поэтому их не нужно сбрасывать
+class DisseminationBarrier {
+private:
+    int total;
+    int rounds = 0;
+    vector<PaddedFlag> flags;       // flags[thread * rounds + round]
+    vector<PaddedFlag> episodes;    // номер текущей эпохи каждого потока
+    
+public:
+    DisseminationBarrier(int n) : total(n), episodes(n) {
+        while ((1 << rounds) < n) {
+            rounds++;
+        }
+        flags = vector<PaddedFlag>(static_cast<size_t>(n) * rounds);
+    }
+    
+    void arrive_and_wait(int thread_id) {
+        unsigned episode = episodes[thread_id].value.load(memory_order_relaxed) + 1;
+        episodes[thread_id].value.store(episode, memory_order_relaxed);
+        
+        for (int r = 0; r < rounds; ++r) {
+            int partner = (thread_id + (1 << r)) % total;
+            flags[partner * rounds + r].value.fetch_add(1, memory_order_release);
+            
+            auto& mine = flags[thread_id * rounds + r].value;
+            spin_until([&]() { return mine.load(memory_order_acquire) >= episode; });
+        }
+    }
+};
+
+// std::barrier (C++20) с интерфейсом наших барьеров
+class StdBarrier {
+private:
+    barrier<> sync_point;
+    
+public:
+    explicit StdBarrier(int num_threads) : sync_point(num_threads) {}
+    
+    void arrive_and_wait(int) { sync_point.arrive_and_wait(); }
+};
+
+// Барьер из одноразовых std::latch (C++20): на каждый раунд своя защелка.
+// Защелку нельзя сбросить, поэтому все раунды создаются заранее
+class LatchBarrier {
+private:
+    vector<unique_ptr<latch>> latches;
+    vector<PaddedCounter> rounds;  // текущий раунд каждого потока
+    
+public:
+    LatchBarrier(int num_threads, int num_rounds) : rounds(num_threads) {
+        for (int r = 0; r < num_rounds; ++r) {
+            latches.push_back(make_unique<latch>(num_threads));
+        }
+    }
+    
+    void arrive_and_wait(int thread_id) {
+        latches[rounds[thread_id].value++]->arrive_and_wait();
+    }
+};
+
+// Единица работы для нагрузки вне и внутри критической секции (~1 нс)
+inline void busy_work(int units) {
+    unsigned x = 1;
+    for (int k = 0; k < units; ++k) {
+        x = x * 1103515245u + 12345u;
+        asm volatile("" : "+r"(x));
+    }
+}
+
+// Пропускная способность последнего run_primitive_test (см. contended_throughput)
+static ThroughputStats last_throughput;
+
+// Общий шаблон теста примитива взаимного исключения.
+// Lock - любой тип с lock()/unlock(), args передаются в его конструктор.
+// Возвращает гистограмму времени ожидания захвата по всем потокам
+// Фиксированная работа: iterations захватов на поток. Режим по времени (workload.duration_ms > 0):
+// потоки захватывают блокировку до конца окна, а последнее задание пула - таймер прогрева и окна.
+// Задержки и операции считаются только внутри окна
+template <typename Lock, typename... Args>
+static LatencyHistogram run_primitive_test(const string& label, int num_threads, int iterations,
+                               const WorkloadConfig& workload, Args&&... args) {
+    Lock primitive(forward<Args>(args)...);
+    atomic<int> counter{0};
+    atomic<int> progress{0};
+    // Общие данные под блокировкой, по одному элементу на кэш-линию
+    vector<PaddedCounter> shared_data(max(0, workload.shared_lines));
+    vector<int> cpu_order = CpuTopology::instance().placement_order(workload.placement);
+    LatencyHistogram latency;
+    mutex latency_mutex;
+    
+    const bool timed = workload.duration_ms > 0;
+    atomic<bool> measuring{!timed};
+    atomic<bool> stop{false};
+    vector<PaddedCounter> ops(num_threads);
+    chrono::steady_clock::time_point window_start;
+    chrono::steady_clock::time_point window_end;
+    PerfSample perf_before;
+    PerfSample perf_after;
+    
+    WorkerPool::instance().run(timed ? num_threads + 1 : num_threads, [&](int i) {
+        if (i == num_threads) {
+            this_thread::sleep_for(chrono::milliseconds(max(0, workload.warmup_ms)));
+            perf_before = PerfCounters::snapshot();
+            window_start = chrono::steady_clock::now();
+            measuring.store(true, memory_order_relaxed);
+            this_thread::sleep_for(chrono::milliseconds(workload.duration_ms));
+            stop.store(true, memory_order_relaxed);
+            window_end = chrono::steady_clock::now();
+            perf_after = PerfCounters::snapshot();
+            return;
+        }
+        
+        Xoshiro256 rng = Xoshiro256::for_thread(benchmark_seed(), i);
+        LatencyHistogram local_latency;
+        long long local_ops = 0;
+        
+        for (long long j = 0; timed ? !stop.load(memory_order_relaxed) : j < iterations; ++j) {
+            busy_work(workload.outside_work);
+            // Случайный символ готовим до захвата, чтобы RNG не мерился как время блокировки
+            char c = static_cast<char>(rng.uniform(33, 126)); // Печатные ASCII символы
+            int value = static_cast<int>(c) * static_cast<int>(j % 256);
+            
+            auto wait_start = chrono::steady_clock::now();
+            chrono::nanoseconds waited;
+            {
+                lock_guard<Lock> lock(primitive);
+                waited = chrono::steady_clock::now() - wait_start;
+                counter += value % 256;
+                progress++;
+                for (auto& line : shared_data) {
+                    line.value += value;
+                }
+                busy_work(workload.critical_work);
+            }
+            if (measuring.load(memory_order_relaxed)) {
+                local_latency.record(waited.count());
+                local_ops++;
+            }
+        }
+        ops[i].value = local_ops;
+        
+        lock_guard<mutex> lock(latency_mutex);
+        latency.merge(local_latency);
+    }, cpu_order);
+    
+    // Без окна пропускная способность считается по времени конкурентной части
+    last_throughput = ThroughputStats{};
+    if (timed) {
+        last_throughput.seconds = chrono::duration<double>(window_end - window_start).count();
+        last_throughput.perf = perf_after - perf_before;
+    } else {
+        last_throughput.seconds = WorkerPool::instance().last_run_microseconds() / 1e6;
+        last_throughput.perf = WorkerPool::instance().last_run_perf();
+    }
+    for (const auto& count : ops) {
+        last_throughput.total_ops += count.value;
+        last_throughput.thread_ops_per_second.push_back(
+            last_throughput.seconds > 0 ? count.value / last_throughput.seconds : 0.0);
+    }
+    last_throughput.ops_per_second = last_throughput.seconds > 0
+        ? last_throughput.total_ops / last_throughput.seconds : 0.0;
+    
+    if (!timed && num_threads * iterations < 1000) {
+        cout << "  [" << label << "] Завершено операций: " << progress.load() 
+                  << ", итоговое значение: " << counter.load() << endl;
+    }
+    return latency;
+}
+
+// Адаптеры к lock()/unlock() для примитивов с другими именами методов
+template <typename SemaphoreT>
+class SemaphoreLock {
+private:
+    SemaphoreT semaphore{1};
+    
+public:
+    void lock() { semaphore.acquire(); }
+    void unlock() { semaphore.release(); }
+};
+
+class MonitorLock {
+private:
+    Monitor monitor;
+    
+public:
+    void lock() { monitor.enter(); }
+    void unlock() { monitor.exit(); }
+};
+
+// Тесты примитивов: один примитив - одна строка
+LatencyHistogram test_mutex(int num_threads, int iterations, const WorkloadConfig& workload) {
+    return run_primitive_test<mutex>("Mutex", num_threads, iterations, workload);
+}
+
+LatencyHistogram test_semaphore(int num_threads, int iterations, const WorkloadConfig& workload) {
+    return run_primitive_test<SemaphoreLock<Semaphore>>("Semaphore", num_threads, iterations,
+                                                        workload);
+}
+
+LatencyHistogram test_fast_semaphore(int num_threads, int iterations,
+                                     const WorkloadConfig& workload) {
+    return run_primitive_test<SemaphoreLock<FastSemaphore>>("FastSemaphore", num_threads,
+                                                            iterations, workload);
+}
+
+LatencyHistogram test_spinlock(int num_threads, int iterations, const WorkloadConfig& workload) {
+    return run_primitive_test<SpinLock>("SpinLock", num_threads, iterations, workload);
+}
+
+LatencyHistogram test_spinwait(int num_threads, int iterations, const WorkloadConfig& workload) {
+    return run_primitive_test<SpinWait>("SpinWait", num_threads, iterations, workload);
+}
+
+LatencyHistogram test_monitor(int num_threads, int iterations, const WorkloadConfig& workload) {
+    return run_primitive_test<MonitorLock>("Monitor", num_threads, iterations, workload);
+}
+
+LatencyHistogram test_ticketlock(int num_threads, int iterations, const WorkloadConfig& workload) {
+    return run_primitive_test<TicketLock>("TicketLock", num_threads, iterations, workload);
+}
+
+LatencyHistogram test_mcslock(int num_threads, int iterations, const WorkloadConfig& workload) {
+    return run_primitive_test<MCSLock>("MCSLock", num_threads, iterations, workload);
+}
+
+LatencyHistogram test_clhlock(int num_threads, int iterations, const WorkloadConfig& workload) {
+    return run_primitive_test<CLHLock>("CLHLock", num_threads, iterations, workload);
+}
+
+LatencyHistogram test_adaptive_mutex(int num_threads, int iterations, int spin_limit,
+                                     const WorkloadConfig& workload) {
+    return run_primitive_test<AdaptiveMutex>("AdaptiveMutex", num_threads, iterations, workload,
+                                             spin_limit);
+}
+
+LatencyHistogram test_std_counting_semaphore(int num_threads, int iterations,
+                                            const WorkloadConfig& workload) {
+    return run_primitive_test<SemaphoreLock<counting_semaphore<>>>("StdCountingSemaphore",
+                                                                   num_threads, iterations,
+                                                                   workload);
+}
+
+LatencyHistogram test_std_binary_semaphore(int num_threads, int iterations,
+                                          const WorkloadConfig& workload) {
+    return run_primitive_test<SemaphoreLock<binary_semaphore>>("StdBinarySemaphore",
+                                                               num_threads, iterations, workload);
+}
+
+LatencyHistogram test_atomic_wait_lock(int num_threads, int iterations,
+                                      const WorkloadConfig& workload) {
+    return run_primitive_test<AtomicWaitLock>("AtomicWaitLock", num_threads, iterations, workload);
+}
+
+LatencyHistogram test_cohort_lock(int num_threads, int iterations, int simulated_nodes,
+                                  const WorkloadConfig& workload) {
+    return run_primitive_test<CohortLock>("CohortLock", num_threads, iterations, workload,
+                                          simulated_nodes);
+}
+
+// Время конкурентной части последнего теста: от стартовых ворот пула до конца последнего потока
+static double contended_microseconds() {
+    return WorkerPool::instance().last_run_microseconds();
+}
+
+// Счетчики perf той же конкурентной части
+static PerfSample contended_perf() {
+    return WorkerPool::instance().last_run_perf();
+}
+
+// Операции в секунду последнего теста взаимного исключения (в режиме по времени - за окно)
+static const ThroughputStats& contended_throughput() {
+    return last_throughput;
+}
+
+// Тест справедливости: потоки захватывают блокировку в течение duration_ms.
+// Считаем захваты каждого потока и самую длинную серию захватов одним владельцем подряд
+template <typename Lock>
+static FairnessStats fairness_test(int num_threads, int duration_ms) {
+    Lock primitive;
+    vector<PaddedCounter> acquisitions(num_threads);
+    atomic<bool> stop{false};
+    
+    // Под блокировкой: кто держал ее последним и сколько раз подряд
+    int last_owner = -1;
+    long long streak = 0;
+    long long max_streak = 0;
+    
+    // Последнее задание пула - таймер окна, остальные конкурируют за блокировку
+    WorkerPool::instance().run(num_threads + 1, [&](int i) {
+        if (i == num_threads) {
+            this_thread::sleep_for(chrono::milliseconds(duration_ms));
+            stop.store(true, memory_order_relaxed);
+            return;
+        }
+        long long local_count = 0;
+        while (!stop.load(memory_order_relaxed)) {
+            lock_guard<Lock> lock(primitive);
+            if (last_owner == i) {
+                streak++;
+            } else {
+                last_owner = i;
+                streak = 1;
+            }
+            max_streak = max(max_streak, streak);
+            local_count++;
+        }
+        acquisitions[i].value = local_count;
+    });
+    
+    FairnessStats stats;
+    stats.max_streak = max_streak;
+    double sum = 0.0;
+    double sum_squares = 0.0;
+    for (const auto& a : acquisitions) {
+        stats.acquisitions.push_back(a.value);
+        stats.total += a.value;
+        sum += a.value;
+        sum_squares += static_cast<double>(a.value) * a.value;
+    }
+    // Индекс Джайна: 1 - все потоки получили поровну, 1/n - все досталось одному
+    stats.jain_index = sum_squares > 0 ? sum * sum / (num_threads * sum_squares) : 0.0;
+    return stats;
+}
+
+// Реестр тестов взаимного исключения: новый примитив - одна строка
+using LockTest = function<LatencyHistogram(int, int, const WorkloadConfig&)>;
+using FairnessTest = function<FairnessStats(int, int)>;
+
+struct LockPrimitive {
+    string name;
+    LockTest test;
+    FairnessTest fairness;
+};
+
+static const vector<LockPrimitive>& lock_primitives() {
+    static const vector<LockPrimitive> primitives = {
+        {"Mutex", test_mutex, fairness_test<mutex>},
+        {"Semaphore", test_semaphore, fairness_test<SemaphoreLock<Semaphore>>},
+        {"FastSemaphore", test_fast_semaphore, fairness_test<SemaphoreLock<FastSemaphore>>},
+        {"SpinLock", test_spinlock, fairness_test<SpinLock>},
+        {"SpinWait", test_spinwait, fairness_test<SpinWait>},
+        {"Monitor", test_monitor, fairness_test<MonitorLock>},
+        {"TicketLock", test_ticketlock, fairness_test<TicketLock>},
+        {"MCSLock", test_mcslock, fairness_test<MCSLock>},
+        {"CLHLock", test_clhlock, fairness_test<CLHLock>},
+        {"AdaptiveMutex", [](int t, int i, const WorkloadConfig& w) {
+            return test_adaptive_mutex(t, i, ADAPTIVE_DEFAULT_SPINS, w);
+        }, fairness_test<AdaptiveMutex>},
+        {"CohortLock", [](int t, int i, const WorkloadConfig& w) {
+            return test_cohort_lock(t, i, 0, w);
+        }, fairness_test<CohortLock>},
+        {"StdCountingSemaphore", test_std_counting_semaphore,
+         fairness_test<SemaphoreLock<counting_semaphore<>>>},
+        {"StdBinarySemaphore", test_std_binary_semaphore,
+         fairness_test<SemaphoreLock<binary_semaphore>>},
+        {"AtomicWaitLock", test_atomic_wait_lock, fairness_test<AtomicWaitLock>},
+    };
+    return primitives;
+}
+
+// Название реализации барьера для отчетов
+string barrier_kind_name(BarrierKind kind) {
+    switch (kind) {
+        case BarrierKind::CONDVAR: return "Barrier";
+        case BarrierKind::SENSE: return "SenseBarrier";
+        case BarrierKind::TREE: return "TreeBarrier";
+        case BarrierKind::DISSEMINATION: return "DisseminationBarrier";
+        case BarrierKind::STD_BARRIER: return "StdBarrier";
+        case BarrierKind::STD_LATCH: return "LatchBarrier";
+    }
+    return "Barrier";
+}
+
+// Общая нагрузка теста барьера для любой реализации
+template <typename BarrierT>
+static LatencyHistogram barrier_workload(BarrierT& sync_point, int num_threads, int iterations,
+                                         const string& label) {
+    atomic<int> counter{0};
+    atomic<int> progress{0};
+    LatencyHistogram latency;
+    mutex latency_mutex;
+    
+    WorkerPool::instance().run(num_threads, [&](int i) {
+        Xoshiro256 rng = Xoshiro256::for_thread(benchmark_seed(), i);
+        LatencyHistogram local_latency;
+        
+        for (int j = 0; j < iterations; ++j) {
+            char c = static_cast<char>(rng.uniform(33, 126));
+            int value = static_cast<int>(c) * (j % 256);
+            counter += value % 256;
+            progress++;
+            
+            // Синхронизация в барьере(когда все достигли барьера)
+            auto wait_start = chrono::steady_clock::now();
+            sync_point.arrive_and_wait(i);
+            local_latency.record((chrono::steady_clock::now() - wait_start).count());
+        }
+        
+        lock_guard<mutex> lock(latency_mutex);
+        latency.merge(local_latency);
+    });
+    
+    if (num_threads * iterations < 1000) {
+        cout << "  [" << label << "] Завершено операций: " << progress.load() 
+                  << ", итоговое значение: " << counter.load() << endl;
+    }
+    return latency;
+}
+
+// Тест barrier
+LatencyHistogram test_barrier(int num_threads, int iterations, BarrierKind kind) {
+    string label = barrier_kind_name(kind);
+    switch (kind) {
+        case BarrierKind::CONDVAR: {
+            Barrier sync_point(num_threads);
+            return barrier_workload(sync_point, num_threads, iterations, label);
+        }
+        case BarrierKind::SENSE: {
+            SenseBarrier sync_point(num_threads);
+            return barrier_workload(sync_point, num_threads, iterations, label);
+        }
+        case BarrierKind::TREE: {
+            TreeBarrier sync_point(num_threads);
+            return barrier_workload(sync_point, num_threads, iterations, label);
+        }
+        case BarrierKind::DISSEMINATION: {
+            DisseminationBarrier sync_point(num_threads);
+            return barrier_workload(sync_point, num_threads, iterations, label);
+        }
+        case BarrierKind::STD_BARRIER: {
+            StdBarrier sync_point(num_threads);
+            return barrier_workload(sync_point, num_threads, iterations, label);
+        }
+        case BarrierKind::STD_LATCH: {
+            LatchBarrier sync_point(num_threads, iterations);
+            return barrier_workload(sync_point, num_threads, iterations, label);
+        }
+    }
+    return {};
+}
+
+// Название реализации RW-блокировки для отчетов
+string rwlock_kind_name(RWLockKind kind) {
+    switch (kind) {
+        case RWLockKind::MUTEX: return "RW_Mutex";
+        case RWLockKind::SHARED_MUTEX: return "SharedMutex";
+        case RWLockKind::WRITER_PREFERRING: return "WriterPrefRW";
+        case RWLockKind::BIG_READER: return "BigReaderRW";
+    }
+    return "SharedMutex";
+}
+
+// Общая нагрузка RW-теста: read_percent% операций читают общие данные, остальные пишут.
+// Для MUTEX читатели тоже берут эксклюзивный захват - это базовая линия
+template <typename RWLockT>
+static LatencyHistogram rwlock_workload(RWLockT& rwlock, int num_threads, int iterations,
+                                        int read_percent, const string& label) {
+    atomic<int> reads{0};
+    atomic<int> writes{0};
+    LatencyHistogram latency;
+    mutex latency_mutex;
+    
+    // Общие данные под блокировкой
+    constexpr int DATA_SIZE = 16;
+    int shared_data[DATA_SIZE] = {};
+    
+    WorkerPool::instance().run(num_threads, [&](int i) {
+        Xoshiro256 rng = Xoshiro256::for_thread(benchmark_seed(), i);
+        long long local_sum = 0;
+        int local_reads = 0;
+        int local_writes = 0;
+        LatencyHistogram local_latency;
+        
+        for (int j = 0; j < iterations; ++j) {
+            // Тип операции выбираем до захвата, чтобы не мерить RNG как время блокировки
+            bool is_read = rng.uniform(0, 99) < read_percent;
+            int value = rng.uniform(33, 126) * (j % 256);
+            
+            auto wait_start = chrono::steady_clock::now();
+            chrono::nanoseconds waited;
+            if (is_read) {
+                shared_lock<RWLockT> lock(rwlock);
+                waited = chrono::steady_clock::now() - wait_start;
+                for (int k = 0; k < DATA_SIZE; ++k) {
+                    local_sum += shared_data[k];
+                }
+                local_reads++;
+            } else {
+                lock_guard<RWLockT> lock(rwlock);
+                waited = chrono::steady_clock::now() - wait_start;
+                shared_data[j % DATA_SIZE] += value % 256;
+                local_writes++;
+            }
+            local_latency.record(waited.count());
+        }
+        
+        reads += local_reads;
+        writes += local_writes;
+        // Не даем компилятору выбросить чтения
+        if (local_sum == -1) {
+            cout << local_sum;
+        }
+        
+        lock_guard<mutex> lock(latency_mutex);
+        latency.merge(local_latency);
+    });
+    
+    if (num_threads * iterations < 1000) {
+        cout << "  [" << label << "] Чтений: " << reads.load()
+                  << ", записей: " << writes.load() << endl;
+    }
+    return latency;
+}
+
+// Тест RW-блокировок
+LatencyHistogram test_rwlock(int num_threads, int iterations, int read_percent, RWLockKind kind) {
+    string label = rwlock_kind_name(kind);
+    switch (kind) {
+        case RWLockKind::MUTEX: {
+            // У std::mutex нет lock_shared, читатели идут через эксклюзивный захват
+            struct ExclusiveMutex : mutex {
+                void lock_shared() { lock(); }
+                void unlock_shared() { unlock(); }
+            } rwlock;
+            return rwlock_workload(rwlock, num_threads, iterations, read_percent, label);
+        }
+        case RWLockKind::SHARED_MUTEX: {
+            shared_mutex rwlock;
+            return rwlock_workload(rwlock, num_threads, iterations, read_percent, label);
+        }
+        case RWLockKind::WRITER_PREFERRING: {
+            WriterPreferringRWLock rwlock;
+            return rwlock_workload(rwlock, num_threads, iterations, read_percent, label);
+        }
+        case RWLockKind::BIG_READER: {
+            BigReaderRWLock rwlock;
+            return rwlock_workload(rwlock, num_threads, iterations, read_percent, label);
+        }
+    }
+    return {};
+}
+
+// Название стратегии счетчика для отчетов
+string counter_kind_name(CounterKind kind) {
+    switch (kind) {
+        case CounterKind::FETCH_ADD: return "Counter_FetchAdd";
+        case CounterKind::PER_THREAD: return "Counter_PerThread";
+        case CounterKind::STRIPED: return "Counter_Striped";
+    }
+    return "Counter_FetchAdd";
+}
+
+// Тест счетчиков без блокировки: та же нагрузка, что и в test_*, но без критической секции
+void test_counter(int num_threads, int iterations, CounterKind kind) {
+    atomic<long long> shared_counter{0};
+    atomic<long long> shared_progress{0};
+    vector<PaddedCounter> counter_slots(num_threads);
+    vector<PaddedCounter> progress_slots(num_threads);
+    // Полос меньше, чем потоков, чтобы стратегия отличалась от PER_THREAD
+    int num_stripes = max(1, static_cast<int>(thread::hardware_concurrency()) / 2);
+    StripedCounter striped_counter(num_stripes);
+    StripedCounter striped_progress(num_stripes);
+    
+    WorkerPool::instance().run(num_threads, [&](int i) {
+        Xoshiro256 rng = Xoshiro256::for_thread(benchmark_seed(), i);
+        
+        for (int j = 0; j < iterations; ++j) {
+            char c = static_cast<char>(rng.uniform(33, 126));
+            int value = static_cast<int>(c) * (j % 256);
+            switch (kind) {
+                case CounterKind::FETCH_ADD:
+                    shared_counter.fetch_add(value % 256, memory_order_relaxed);
+                    shared_progress.fetch_add(1, memory_order_relaxed);
+                    break;
+                case CounterKind::PER_THREAD:
+                    counter_slots[i].value += value % 256;
+                    progress_slots[i].value++;
+                    break;
+                case CounterKind::STRIPED:
+                    striped_counter.add(i, value % 256);
+                    striped_progress.add(i, 1);
+                    break;
+            }
+        }
+    });
+    
+    // Сводим результат после join
+    long long counter = 0;
+    long long progress = 0;
+    switch (kind) {
+        case CounterKind::FETCH_ADD:
+            counter = shared_counter.load();
+            progress = shared_progress.load();
+            break;
+        case CounterKind::PER_THREAD:
+            for (int i = 0; i < num_threads; ++i) {
+                counter += counter_slots[i].value;
+                progress += progress_slots[i].value;
+            }
+            break;
+        case CounterKind::STRIPED:
+            counter = striped_counter.sum();
+            progress = striped_progress.sum();
+            break;
+    }
+    
+    if (num_threads * iterations < 1000) {
+        cout << "  [" << counter_kind_name(kind) << "] Завершено операций: " << progress
+                  << ", итоговое значение: " << counter << endl;
+    }
+}
+
+// Название пути чтения для отчетов
+string read_path_kind_name(ReadPathKind kind) {
+    switch (kind) {
+        case ReadPathKind::MUTEX: return "ReadMutex";
+        case ReadPathKind::MONITOR: return "ReadMonitor";
+        case ReadPathKind::SEQLOCK: return "SeqLock";
+        case ReadPathKind::RCU: return "EpochRCU";
+    }
+    return "ReadMutex";
+}
+
+// Общее состояние read-mostly теста: писатель держит все значения равными,
+// поэтому рваный снимок виден по разным значениям
+constexpr int READ_PATH_VALUES = 8;
+
+struct ReadPathSnapshot {
+    long long values[READ_PATH_VALUES] = {};
+};
+
+// Хранилища с одинаковым интерфейсом: read(reader, out) копирует снимок, write(v) пишет v
+template <typename Lock>
+class LockedSnapshotStore {
+private:
+    Lock lock;
+    ReadPathSnapshot data;
+    
+public:
+    void read(int, ReadPathSnapshot& out) {
+        lock_guard<Lock> guard(lock);
+        out = data;
+    }
+    
+    void write(long long value) {
+        lock_guard<Lock> guard(lock);
+        for (auto& v : data.values) {
+            v = value;
+        }
+    }
+};
+
+class SeqLockStore {
+private:
+    SeqLock seqlock;
+    atomic<long long> values[READ_PATH_VALUES] = {};
+    
+public:
+    void read(int, ReadPathSnapshot& out) {
+        unsigned seq;
+        do {
+            seq = seqlock.read_begin();
+            for (int k = 0; k < READ_PATH_VALUES; ++k) {
+                out.values[k] = values[k].load(memory_order_relaxed);
+            }
+        } while (seqlock.read_retry(seq));
+    }
+    
+    void write(long long value) {
+        seqlock.write_lock();
+        for (auto& v : values) {
+            v.store(value, memory_order_relaxed);
+        }
+        seqlock.write_unlock();
+    }
+};
+
+class RcuStore {
+private:
+    EpochRcu<ReadPathSnapshot> rcu;
+    
+public:
+    explicit RcuStore(int readers) : rcu(readers, ReadPathSnapshot{}) {}
+    
+    void read(int reader, ReadPathSnapshot& out) {
+        out = *rcu.read_lock(reader);
+        rcu.read_unlock(reader);
+    }
+    
+    void write(long long value) {
+        rcu.update([value](ReadPathSnapshot& snapshot) {
+            for (auto& v : snapshot.values) {
+                v = value;
+            }
+        });
+    }
+};
+
+// Ожидание до момента времени: длинные паузы сном, короткие - спином
+static void wait_until_time(chrono::steady_clock::time_point target) {
+    while (true) {
+        auto now = chrono::steady_clock::now();
+        if (now >= target) return;
+        if (target - now > 200us) {
+            this_thread::sleep_for(target - now - 100us);
+        } else {
+            cpu_relax();
+        }
+    }
+}
+
+// readers читателей копируют снимок в цикле, последнее задание пула - писатель и таймер окна.
+// write_interval_us < 0 - без записей, 0 - писатель пишет без пауз
+template <typename Store>
+static ReadPathStats read_path_workload(Store& store, int readers, int duration_ms,
+                                        int write_interval_us) {
+    atomic<bool> stop{false};
+    vector<PaddedCounter> reads(readers);
+    vector<PaddedCounter> torn(readers);
+    long long writes = 0;
+    
+    WorkerPool::instance().run(readers + 1, [&](int i) {
+        if (i == readers) {
+            auto deadline = chrono::steady_clock::now() + chrono::milliseconds(duration_ms);
+            long long version = 0;
+            while (chrono::steady_clock::now() < deadline) {
+                if (write_interval_us < 0) {
+                    wait_until_time(deadline);
+                    break;
+                }
+                store.write(++version);
+                writes++;
+                auto next = chrono::steady_clock::now() + chrono::microseconds(write_interval_us);
+                wait_until_time(min(next, deadline));
+            }
+            stop.store(true, memory_order_relaxed);
+            return;
+        }
+        
+        ReadPathSnapshot snapshot;
+        long long local_reads = 0;
+        long long local_torn = 0;
+        long long checksum = 0;
+        while (!stop.load(memory_order_relaxed)) {
+            store.read(i, snapshot);
+            for (int k = 1; k < READ_PATH_VALUES; ++k) {
+                if (snapshot.values[k] != snapshot.values[0]) {
+                    local_torn++;
+                    break;
+                }
+            }
+            checksum += snapshot.values[0];
+            local_reads++;
+        }
+        reads[i].value = local_reads;
+        torn[i].value = local_torn;
+        // Не даем компилятору выбросить чтения
+        if (checksum == -1) {
+            cout << checksum;
+        }
+    });
+    
+    ReadPathStats stats;
+    stats.writes = writes;
+    long long total_reads = 0;
+    for (int i = 0; i < readers; ++i) {
+        total_reads += reads[i].value;
+        stats.torn_reads += torn[i].value;
     }
-    
-    if (num_threads * iterations < 1000) {
-        cout << "  [Semaphore] Завершено операций: " << progress.load() 
-                  << ", итоговое значение: " << counter.load() << endl;
+    stats.reads_per_second = total_reads / (duration_ms / 1000.0);
+    return stats;
+}
+
+// Тест путей чтения read-mostly данных
+ReadPathStats test_read_path(int readers, int duration_ms, int write_interval_us,
+                             ReadPathKind kind) {
+    switch (kind) {
+        case ReadPathKind::MUTEX: {
+            LockedSnapshotStore<mutex> store;
+            return read_path_workload(store, readers, duration_ms, write_interval_us);
+        }
+        case ReadPathKind::MONITOR: {
+            LockedSnapshotStore<MonitorLock> store;
+            return read_path_workload(store, readers, duration_ms, write_interval_us);
+        }
+        case ReadPathKind::SEQLOCK: {
+            SeqLockStore store;
+            return read_path_workload(store, readers, duration_ms, write_interval_us);
+        }
+        case ReadPathKind::RCU: {
+            RcuStore store(readers);
+            return read_path_workload(store, readers, duration_ms, write_interval_us);
+        }
     }
+    return {};
 }
 
-// Тест barrier
-void test_barrier(int num_threads, int iterations) {
-    Barrier sync_point(num_threads);
-    vector<thread> threads;
-    atomic<int> counter{0};
-    atomic<int> progress{0};
-    
-    for (int i = 0; i < num_threads; ++i) {
-        threads.emplace_back([&, i]() {
-            random_device rd;
-            mt19937 gen(rd());
-            uniform_int_distribution<> dis(33, 126);
-            
-            for (int j = 0; j < iterations; ++j) {
-                char c = static_cast<char>(dis(gen));
-                int value = static_cast<int>(c) * (j % 256);
-                counter += value % 256;
-                progress++;
-                
-                // Синхронизация в барьере(когда все достигли барьера)
-                sync_point.arrive_and_wait();
-            }
-        });
+// Название общей структуры и способа синхронизации для отчетов
+string combining_structure_name(CombiningStructure structure) {
+    switch (structure) {
+        case CombiningStructure::COUNTER: return "Counter";
+        case CombiningStructure::PRIORITY_QUEUE: return "PriorityQueue";
     }
-    
-    for (auto& t : threads) {
-        t.join();
+    return "Counter";
+}
+
+string combining_sync_name(CombiningSync sync) {
+    switch (sync) {
+        case CombiningSync::MUTEX: return "Mutex";
+        case CombiningSync::SPINLOCK: return "SpinLock";
+        case CombiningSync::FLAT_COMBINING: return "FlatCombining";
     }
+    return "Mutex";
+}
+
+// Исполнитель операций под обычной блокировкой (тот же интерфейс, что у FlatCombiner)
+template <typename Lock>
+class LockExecutor {
+private:
+    Lock lock;
     
-    if (num_threads * iterations < 1000) {
-        cout << "  [Barrier] Завершено операций: " << progress.load() 
-                  << ", итоговое значение: " << counter.load() << endl;
+public:
+    template <typename Operation>
+    void execute(int, Operation& op) {
+        lock_guard<Lock> guard(lock);
+        op();
     }
-}
+};
 
-// Тест spinlock
-void test_spinlock(int num_threads, int iterations) {
-    SpinLock spinlock;
-    vector<thread> threads;
-    atomic<int> counter{0};
-    atomic<int> progress{0};
+// Операции над общей структурой через исполнитель. Задержка - от публикации до выполнения
+template <typename Executor>
+static LatencyHistogram combining_workload(Executor& executor, int num_threads, int iterations,
+                                           CombiningStructure structure) {
+    long long counter = 0;
+    long long progress = 0;
+    // Маленькая очередь с приоритетом: держим не больше PQ_LIMIT элементов
+    constexpr size_t PQ_LIMIT = 64;
+    priority_queue<int> heap;
+    LatencyHistogram latency;
+    mutex latency_mutex;
     
-    for (int i = 0; i < num_threads; ++i) {
-        threads.emplace_back([&, i]() {
-            random_device rd;
-            mt19937 gen(rd());
-            uniform_int_distribution<> dis(33, 126);
-            
-            for (int j = 0; j < iterations; ++j) {
-                lock_guard<SpinLock> lock(spinlock);
-                char c = static_cast<char>(dis(gen));
-                int value = static_cast<int>(c) * (j % 256);
-                counter += value % 256;
-                progress++;
+    WorkerPool::instance().run(num_threads, [&](int i) {
+        Xoshiro256 rng = Xoshiro256::for_thread(benchmark_seed(), i);
+        LatencyHistogram local_latency;
+        
+        for (int j = 0; j < iterations; ++j) {
+            int value = rng.uniform(33, 126) * (j % 256);
+            auto op_start = chrono::steady_clock::now();
+            if (structure == CombiningStructure::COUNTER) {
+                auto op = [&]() {
+                    counter += value % 256;
+                    progress++;
+                };
+                executor.execute(i, op);
+            } else {
+                auto op = [&]() {
+                    heap.push(value);
+                    if (heap.size() > PQ_LIMIT) {
+                        heap.pop();
+                    }
+                    progress++;
+                };
+                executor.execute(i, op);
             }
-        });
-    }
+            local_latency.record((chrono::steady_clock::now() - op_start).count());
+        }
+        
+        lock_guard<mutex> lock(latency_mutex);
+        latency.merge(local_latency);
+    });
     
-    for (auto& t : threads) {
-        t.join();
+    if (progress != static_cast<long long>(num_threads) * iterations) {
+        cout << "  [" << combining_structure_name(structure) << "] Потеряны операции: "
+             << progress << " из " << static_cast<long long>(num_threads) * iterations << endl;
     }
-    
-    if (num_threads * iterations < 1000) {
-        cout << "  [SpinLock] Завершено операций: " << progress.load() 
-                  << ", итоговое значение: " << counter.load() << endl;
+    return latency;
+}
+
+// Тест flat combining против Mutex и SpinLock на одной и той же структуре
+LatencyHistogram test_combining(int num_threads, int iterations, CombiningStructure structure,
+                                CombiningSync sync) {
+    switch (sync) {
+        case CombiningSync::MUTEX: {
+            LockExecutor<mutex> executor;
+            return combining_workload(executor, num_threads, iterations, structure);
+        }
+        case CombiningSync::SPINLOCK: {
+            LockExecutor<SpinLock> executor;
+            return combining_workload(executor, num_threads, iterations, structure);
+        }
+        case CombiningSync::FLAT_COMBINING: {
+            FlatCombiner executor(num_threads);
+            return combining_workload(executor, num_threads, iterations, structure);
+        }
     }
+    return {};
 }
 
-// Тест spinwait
-void test_spinwait(int num_threads, int iterations) {
-    SpinWait spinwait;
-    vector<thread> threads;
-    atomic<int> counter{0};
-    atomic<int> progress{0};
+// Название реализации очереди для отчетов
+string queue_kind_name(QueueKind kind) {
+    switch (kind) {
+        case QueueKind::MUTEX_QUEUE: return "MutexQueue";
+        case QueueKind::MPMC_RING: return "MPMCRing";
+    }
+    return "MutexQueue";
+}
+
+// Сообщение очереди: момент постановки нужен для задержки передачи
+struct QueueMessage {
+    long long enqueue_ns = 0;
+    int value = 0;
+};
+
+// Производители/потребители поверх любой очереди с try_push/try_pop.
+// Завершение: последний производитель кладет по одному стоп-сообщению (value < 0)
+// на каждого потребителя
+template <typename QueueT>
+static QueueStats queue_workload(QueueT& channel, int producers, int consumers,
+                                 int messages_per_producer) {
+    QueueStats stats;
+    mutex latency_mutex;
+    atomic<long long> checksum{0};
     
-    for (int i = 0; i < num_threads; ++i) {
-        threads.emplace_back([&, i]() {
-            random_device rd;
-            mt19937 gen(rd());
-            uniform_int_distribution<> dis(33, 126);
+    auto now_ns = []() {
+        return chrono::duration_cast<chrono::nanoseconds>(
+            chrono::steady_clock::now().time_since_epoch()).count();
+    };
+    
+    auto push = [&](const QueueMessage& message) {
+        for (unsigned spins = 0; !channel.try_push(message); ++spins) {
+            if (spins < 64) cpu_relax(); else this_thread::yield();
+        }
+    };
+    
+    // Задания пула: сначала потребители, затем производители.
+    // Последний завершившийся производитель рассылает стоп-сообщения
+    atomic<int> producers_left{producers};
+    stats.elapsed_us = WorkerPool::instance().run(consumers + producers, [&](int i) {
+        if (i < consumers) {
+            LatencyHistogram local_latency;
+            long long local_sum = 0;
+            QueueMessage message;
             
-            for (int j = 0; j < iterations; ++j) {
-                lock_guard<SpinWait> lock(spinwait);
-                char c = static_cast<char>(dis(gen));
-                int value = static_cast<int>(c) * (j % 256);
-                counter += value % 256;
-                progress++;
+            while (true) {
+                for (unsigned spins = 0; !channel.try_pop(message); ++spins) {
+                    if (spins < 64) cpu_relax(); else this_thread::yield();
+                }
+                if (message.value < 0) {
+                    break;
+                }
+                local_latency.record(now_ns() - message.enqueue_ns);
+                local_sum += message.value;
             }
-        });
-    }
+            
+            checksum += local_sum;
+            lock_guard<mutex> lock(latency_mutex);
+            stats.handoff_latency.merge(local_latency);
+            return;
+        }
+        
+        int p = i - consumers;
+        Xoshiro256 rng = Xoshiro256::for_thread(benchmark_seed(), p);
+        for (int j = 0; j < messages_per_producer; ++j) {
+            QueueMessage message;
+            message.value = rng.uniform(33, 126);
+            message.enqueue_ns = now_ns();
+            push(message);
+        }
+        if (producers_left.fetch_sub(1, memory_order_acq_rel) == 1) {
+            for (int c = 0; c < consumers; ++c) {
+                QueueMessage stop;
+                stop.value = -1;
+                push(stop);
+            }
+        }
+    });
+    long long total = static_cast<long long>(producers) * messages_per_producer;
+    stats.messages_per_second = stats.elapsed_us > 0 ? total / (stats.elapsed_us / 1e6) : 0.0;
     
-    for (auto& t : threads) {
-        t.join();
+    if (stats.handoff_latency.count() != static_cast<uint64_t>(total)) {
+        cout << "  [Очередь] Потеряны сообщения: получено " << stats.handoff_latency.count()
+                  << " из " << total << endl;
     }
-    
-    if (num_threads * iterations < 1000) {
-        cout << "  [SpinWait] Завершено операций: " << progress.load() 
-                  << ", итоговое значение: " << counter.load() << endl;
+    return stats;
+}
+
+// Тест производителей и потребителей
+QueueStats test_queue(int producers, int consumers, int messages_per_producer, QueueKind kind) {
+    const size_t capacity = 1024;
+    switch (kind) {
+        case QueueKind::MUTEX_QUEUE: {
+            LockedQueue<QueueMessage> channel(capacity);
+            return queue_workload(channel, producers, consumers, messages_per_producer);
+        }
+        case QueueKind::MPMC_RING: {
+            MPMCQueue<QueueMessage> channel(capacity);
+            return queue_workload(channel, producers, consumers, messages_per_producer);
+        }
     }
+    return {};
 }
 
-// Тест monitor
-void test_monitor(int num_threads, int iterations) {
-    Monitor monitor;
-    vector<thread> threads;
-    atomic<int> counter{0};
-    atomic<int> progress{0};
+// benchmark all
+// Режим по времени: каждый примитив захватывается workload.duration_ms после прогрева,
+// результат - операций в секунду всего и по потокам
+static void benchmark_primitives_throughput(int num_threads, const WorkloadConfig& workload) {
+    cout << "\n=== Пропускная способность примитивов (режим по времени) ===\n";
+    cout << "Параметры: " << num_threads << " потоков, прогрев " << workload.warmup_ms
+              << " мс, окно " << workload.duration_ms << " мс\n";
+    cout << "Нагрузка: " << workload.critical_work << " нс в критической секции, "
+              << workload.shared_lines << " кэш-линий общих данных, "
+              << workload.outside_work << " нс между захватами\n";
+    cout << "Seed генератора: " << benchmark_seed() << " (переменная BENCH_SEED)\n\n";
+    
+    cout << setw(22) << left << "Примитив"
+              << setw(16) << "Опер/с"
+              << setw(16) << "Мин/поток"
+              << setw(16) << "Макс/поток"
+              << setw(12) << "p99 (нс)" << "\n";
+    cout << string(82, '-') << endl;
     
+    vector<string> names;
+    vector<vector<double>> rows;
+    vector<string> columns = {"Опер_в_сек", "Всего_операций", "Окно_сек", "p99_нс"};
     for (int i = 0; i < num_threads; ++i) {
-        threads.emplace_back([&, i]() {
-            random_device rd;
-            mt19937 gen(rd());
-            uniform_int_distribution<> dis(33, 126);
-            
-            for (int j = 0; j < iterations; ++j) {
-                monitor.enter();
-                char c = static_cast<char>(dis(gen));
-                int value = static_cast<int>(c) * (j % 256);
-                counter += value % 256;
-                progress++;
-                monitor.exit();
-            }
-        });
+        columns.push_back("Поток_" + to_string(i) + "_опер_в_сек");
     }
+    vector<pair<string, double>> results;
+    vector<PerfSample> perf;
     
-    for (auto& t : threads) {
-        t.join();
+    for (const auto& primitive : lock_primitives()) {
+        LatencyHistogram latency = primitive.test(num_threads, 0, workload);
+        const ThroughputStats& stats = contended_throughput();
+        auto [min_it, max_it] = minmax_element(stats.thread_ops_per_second.begin(),
+                                               stats.thread_ops_per_second.end());
+        
+        cout << setw(22) << left << primitive.name
+                  << setw(16) << fixed << setprecision(0) << stats.ops_per_second
+                  << setw(16) << *min_it
+                  << setw(16) << *max_it
+                  << setw(12) << latency.percentile(99.0) << endl;
+        
+        names.push_back(primitive.name);
+        vector<double> row = {stats.ops_per_second, static_cast<double>(stats.total_ops),
+                              stats.seconds, latency.percentile(99.0)};
+        row.insert(row.end(), stats.thread_ops_per_second.begin(),
+                   stats.thread_ops_per_second.end());
+        rows.push_back(row);
+        results.emplace_back(primitive.name, stats.seconds * 1e6);
+        perf.push_back(stats.perf);
     }
+    cout << string(82, '-') << endl;
     
-    if (num_threads * iterations < 1000) {
-        cout << "  [Monitor] Завершено операций: " << progress.load() 
-                  << ", итоговое значение: " << counter.load() << endl;
-    }
+    Benchmark::print_perf(results, perf, "Счетчики производительности за окно замера");
+    Benchmark::save_matrix_to_csv(names, columns, rows, "throughput_benchmark.csv");
 }
 
-// benchmark all
-void benchmark_all_primitives(int num_threads, int iterations) {
+void benchmark_all_primitives(int num_threads, int iterations, const WorkloadConfig& workload) {
+    if (workload.duration_ms > 0) {
+        benchmark_primitives_throughput(num_threads, workload);
+        return;
+    }
+    
     cout << "\n=== Тестирование примитивов синхронизации ===\n";
     cout << "Параметры: " << num_threads << " потоков, " 
               << iterations << " итераций на поток\n";
-    cout << "Общее количество операций: " << num_threads * iterations << "\n\n";
+    cout << "Общее количество операций: " << num_threads * iterations << "\n";
+    cout << "Нагрузка: " << workload.critical_work << " нс в критической секции, "
+              << workload.shared_lines << " кэш-линий общих данных, "
+              << workload.outside_work << " нс между захватами\n";
+    cout << "Seed генератора: " << benchmark_seed() << " (переменная BENCH_SEED)\n\n";
     
     vector<pair<string, double>> results;
+    vector<LatencyHistogram> latencies;  // по одной на каждый результат
+    vector<PerfSample> perf;
     
-    {
-        Benchmark b("Mutex тест", false);
-        test_mutex(num_threads, iterations);
-        results.emplace_back("Mutex", b.elapsed_microseconds());
-    }
-    
-    {
-        Benchmark b("Semaphore тест", false);
-        test_semaphore(num_threads, iterations);
-        results.emplace_back("Semaphore", b.elapsed_microseconds());
-    }
+    // Примитивы взаимного исключения из реестра; барьеры в отчете идут сразу после семафоров
+    const auto& primitives = lock_primitives();
+    auto add_lock = [&](const LockPrimitive& primitive) {
+        latencies.push_back(primitive.test(num_threads, iterations, workload));
+        results.emplace_back(primitive.name, contended_microseconds());
+        perf.push_back(contended_perf());
+    };
+    auto after_semaphores = primitives.begin() + min<size_t>(3, primitives.size());
+    for_each(primitives.begin(), after_semaphores, add_lock);
     
-    {
-        Benchmark b("Barrier тест", false);
-        test_barrier(num_threads, iterations);
-        results.emplace_back("Barrier", b.elapsed_microseconds());
+    for (BarrierKind kind : ALL_BARRIER_KINDS) {
+        latencies.push_back(test_barrier(num_threads, iterations, kind));
+        results.emplace_back(barrier_kind_name(kind), contended_microseconds());
+        perf.push_back(contended_perf());
     }
     
-    {
-        Benchmark b("SpinLock тест", false);
-        test_spinlock(num_threads, iterations);
-        results.emplace_back("SpinLock", b.elapsed_microseconds());
-    }
+    for_each(after_semaphores, primitives.end(), add_lock);
     
-    {
-        Benchmark b("SpinWait тест", false);
-        test_spinwait(num_threads, iterations);
-        results.emplace_back("SpinWait", b.elapsed_microseconds());
+    // Счетчики без блокировки
+    for (CounterKind kind : ALL_COUNTER_KINDS) {
+        test_counter(num_threads, iterations, kind);
+        latencies.emplace_back();
+        results.emplace_back(counter_kind_name(kind), contended_microseconds());
+        perf.push_back(contended_perf());
     }
     
-    {
-        Benchmark b("Monitor тест", false);
-        test_monitor(num_threads, iterations);
-        results.emplace_back("Monitor", b.elapsed_microseconds());
+    // RW-блокировки при разной доле чтений
+    for (int read_percent : {50, 90, 99}) {
+        for (RWLockKind kind : ALL_RWLOCK_KINDS) {
+            string name = rwlock_kind_name(kind) + "_r" + to_string(read_percent);
+            latencies.push_back(test_rwlock(num_threads, iterations, read_percent, kind));
+            results.emplace_back(name, contended_microseconds());
+            perf.push_back(contended_perf());
+        }
     }
     
     Benchmark::print_results(results, "Сравнение примитивов синхронизации");
-    Benchmark::save_to_csv(results, "primitives_benchmark.csv");
+    Benchmark::print_latency(results, latencies);
+    Benchmark::print_perf(results, perf);
+    Benchmark::save_to_csv(results, latencies, perf, "primitives_benchmark.csv");
     Benchmark::print_statistics(results);
 }
 
@@ -379,31 +2088,42 @@ void run_scalability_test() {
     const int iterations = 1000;
     
     cout << "Фиксированное количество итераций на поток: " << iterations << "\n";
-    cout << "Тестируем примитив: Mutex (как пример)\n\n";
+    cout << "Тестируем примитив: Mutex (как пример)\n";
+    cout << "Топология: " << CpuTopology::instance().summary() << "\n\n";
     
-    vector<pair<string, double>> scalability_results;
+    vector<pair<string, double>> all_results;
     
-    for (int threads : thread_counts) {
-        Benchmark b("Масштабируемость: " + to_string(threads) + " потоков", false);
-        test_mutex(threads, iterations);
-        double time = b.elapsed_microseconds();
-        scalability_results.emplace_back(to_string(threads) + " потоков", time);
+    for (PlacementPolicy policy : ALL_PLACEMENT_POLICIES) {
+        WorkloadConfig workload;
+        workload.placement = policy;
+        
+        vector<pair<string, double>> scalability_results;
+        
+        for (int threads : thread_counts) {
+            test_mutex(threads, iterations, workload);
+            double time = contended_microseconds();
+            scalability_results.emplace_back(to_string(threads) + " потоков", time);
+            all_results.emplace_back(
+                "Mutex_" + placement_name(policy) + "_" + to_string(threads) + "t", time);
+        }
+        
+        cout << "\nРезультаты масштабируемости (размещение: " << placement_name(policy) << "):\n";
+        cout << setw(15) << left << "Потоки"
+                  << setw(15) << "Время (мкс)"
+                  << setw(15) << "Ускорение" << "\n";
+        cout << string(45, '-') << endl;
+        
+        double base_time = scalability_results[0].second;
+        for (const auto& result : scalability_results) {
+            double speedup = base_time / result.second;
+            cout << setw(15) << left << result.first
+                      << setw(15) << fixed << setprecision(2) << result.second
+                      << setw(15) << fixed << setprecision(2) << speedup << "x\n";
+        }
+        cout << string(45, '-') << endl;
     }
     
-    cout << "\nРезультаты масштабируемости:\n";
-    cout << setw(15) << left << "Потоки"
-              << setw(15) << "Время (мкс)"
-              << setw(15) << "Ускорение" << "\n";
-    cout << string(45, '-') << endl;
-    
-    double base_time = scalability_results[0].second;
-    for (const auto& result : scalability_results) {
-        double speedup = base_time / result.second;
-        cout << setw(15) << left << result.first
-                  << setw(15) << fixed << setprecision(2) << result.second
-                  << setw(15) << fixed << setprecision(2) << speedup << "x\n";
-    }
-    cout << string(45, '-') << endl;
+    Benchmark::save_to_csv(all_results, "scalability_benchmark.csv");
 }
 
 // расширенный бенчмарк(разные параметры)
@@ -415,74 +2135,512 @@ void run_extended_benchmark() {
     vector<int> iteration_options = {100, 500, 1000};
     
     vector<pair<string, double>> all_results;
+    vector<LatencyHistogram> all_latencies;
+    vector<PerfSample> all_perf;
     
     for (int threads : thread_options) {
         for (int iterations : iteration_options) {
             cout << "\n--- Конфигурация: " << threads << " потоков, " 
                       << iterations << " итераций ---\n";
+            string suffix = "_" + to_string(threads) + "t_" + to_string(iterations) + "i";
             
-            {
-                Benchmark b("Mutex", false);
-                test_mutex(threads, iterations);
-                all_results.emplace_back(
-                    "Mutex_" + to_string(threads) + "t_" + to_string(iterations) + "i",
-                    b.elapsed_microseconds()
-                );
+            for (const auto& primitive : lock_primitives()) {
+                all_latencies.push_back(primitive.test(threads, iterations, WorkloadConfig{}));
+                all_results.emplace_back(primitive.name + suffix, contended_microseconds());
+                all_perf.push_back(contended_perf());
             }
             
-            {
-                Benchmark b("Semaphore", false);
-                test_semaphore(threads, iterations);
-                all_results.emplace_back(
-                    "Semaphore_" + to_string(threads) + "t_" + to_string(iterations) + "i",
-                    b.elapsed_microseconds()
-                );
+            // Адаптивный мьютекс с разной длиной спина: 0 - сразу в futex
+            for (int spins : {0, 10 * ADAPTIVE_DEFAULT_SPINS}) {
+                all_latencies.push_back(test_adaptive_mutex(threads, iterations, spins));
+                all_results.emplace_back("AdaptiveMutex" + to_string(spins) + suffix,
+                                         contended_microseconds());
+                all_perf.push_back(contended_perf());
             }
             
-            // Для ускорения тестирования, остальные примитивы можно тестировать
-            // только при определенных конфигурациях
-            if (threads == 4 && iterations == 500) {
-                {
-                    Benchmark b("Barrier", false);
-                    test_barrier(threads, iterations);
-                    all_results.emplace_back(
-                        "Barrier_" + to_string(threads) + "t_" + to_string(iterations) + "i",
-                        b.elapsed_microseconds()
-                    );
-                }
-                
-                {
-                    Benchmark b("SpinLock", false);
-                    test_spinlock(threads, iterations);
-                    all_results.emplace_back(
-                        "SpinLock_" + to_string(threads) + "t_" + to_string(iterations) + "i",
-                        b.elapsed_microseconds()
-                    );
-                }
+            for (BarrierKind kind : ALL_BARRIER_KINDS) {
+                all_latencies.push_back(test_barrier(threads, iterations, kind));
+                all_results.emplace_back(barrier_kind_name(kind) + suffix, contended_microseconds());
+                all_perf.push_back(contended_perf());
+            }
+            
+            for (CounterKind kind : ALL_COUNTER_KINDS) {
+                test_counter(threads, iterations, kind);
+                all_latencies.emplace_back();
+                all_results.emplace_back(counter_kind_name(kind) + suffix, contended_microseconds());
+                all_perf.push_back(contended_perf());
             }
         }
     }
     
-    Benchmark::save_to_csv(all_results, "extended_benchmark.csv");
+    Benchmark::print_perf(all_results, all_perf);
+    Benchmark::save_to_csv(all_results, all_latencies, all_perf, "extended_benchmark.csv");
     cout << "\nРасширенный бенчмарк завершен. Результаты сохранены в extended_benchmark.csv\n";
 }
 
+// сравнение барьеров при разном количестве потоков
+void run_barrier_benchmark() {
+    cout << "\n=== Сравнение реализаций барьера ===\n";
+    
+    vector<int> thread_counts = {2, 4, 8, 16};
+    const int iterations = 500;
+    
+    cout << "Фиксированное количество фаз: " << iterations << "\n\n";
+    
+    vector<pair<string, double>> barrier_results;
+    
+    cout << setw(10) << left << "Потоки";
+    for (BarrierKind kind : ALL_BARRIER_KINDS) {
+        cout << setw(24) << barrier_kind_name(kind);
+    }
+    cout << "\n" << string(10 + 24 * size(ALL_BARRIER_KINDS), '-') << endl;
+    
+    for (int threads : thread_counts) {
+        cout << setw(10) << left << threads;
+        for (BarrierKind kind : ALL_BARRIER_KINDS) {
+            test_barrier(threads, iterations, kind);
+            double time = contended_microseconds();
+            
+            // Время одной фазы барьера
+            ostringstream cell;
+            cell << fixed << setprecision(2) << time / iterations << " мкс/фаза";
+            cout << setw(24) << cell.str();
+            
+            barrier_results.emplace_back(
+                barrier_kind_name(kind) + "_" + to_string(threads) + "t_" +
+                to_string(iterations) + "i",
+                time
+            );
+        }
+        cout << endl;
+    }
+    
+    Benchmark::save_to_csv(barrier_results, "barrier_benchmark.csv");
+}
+
+// сравнение примитивов при разной длине критической секции
+void run_workload_sweep() {
+    cout << "\n=== Зависимость от длины критической секции ===\n";
+    
+    const int num_threads = 4;
+    const int iterations = 1000;
+    vector<int> hold_times = {0, 50, 500, 5000};
+    
+    cout << "Параметры: " << num_threads << " потоков, " << iterations
+              << " итераций, 4 кэш-линии общих данных, 100 нс между захватами\n\n";
+    
+    vector<pair<string, double>> sweep_results;
+    
+    cout << setw(16) << left << "Примитив";
+    for (int hold : hold_times) {
+        cout << setw(14) << ("CS=" + to_string(hold) + "нс");
+    }
+    cout << "\n" << string(16 + 14 * hold_times.size(), '-') << endl;
+    
+    for (const auto& primitive : lock_primitives()) {
+        const string& name = primitive.name;
+        cout << setw(16) << left << name;
+        for (int hold : hold_times) {
+            WorkloadConfig workload;
+            workload.critical_work = hold;
+            workload.shared_lines = 4;
+            workload.outside_work = 100;
+            
+            primitive.test(num_threads, iterations, workload);
+            double time = contended_microseconds();
+            
+            cout << setw(14) << fixed << setprecision(0) << time;
+            sweep_results.emplace_back(name + "_cs" + to_string(hold), time);
+        }
+        cout << endl;
+    }
+    
+    Benchmark::save_to_csv(sweep_results, "workload_benchmark.csv");
+}
+
+// полный прогон всех примитивов по числу потоков, включая переподписку
+void run_contention_sweep() {
+    cout << "\n=== Прогон по числу потоков для всех примитивов ===\n";
+    
+    int hardware = max(1, static_cast<int>(thread::hardware_concurrency()));
+    vector<int> thread_counts;
+    for (int t = 1; t < hardware; t *= 2) {
+        thread_counts.push_back(t);
+    }
+    thread_counts.push_back(hardware);
+    thread_counts.push_back(2 * hardware);  // переподписка x2
+    thread_counts.push_back(4 * hardware);  // переподписка x4
+    
+    const int iterations = 2000;
+    
+    cout << "hardware_concurrency: " << hardware << ", итераций на поток: " << iterations << "\n";
+    cout << "Число потоков:";
+    for (int t : thread_counts) {
+        cout << " " << t;
+    }
+    cout << "\n\n";
+    
+    // Все примитивы: блокировки из реестра, барьеры, RW (90% чтений) и счетчики без блокировки
+    vector<pair<string, LockTest>> primitives;
+    for (const auto& primitive : lock_primitives()) {
+        primitives.emplace_back(primitive.name, primitive.test);
+    }
+    for (BarrierKind kind : ALL_BARRIER_KINDS) {
+        primitives.emplace_back(barrier_kind_name(kind), [kind](int t, int i, const WorkloadConfig&) {
+            return test_barrier(t, i, kind);
+        });
+    }
+    for (RWLockKind kind : ALL_RWLOCK_KINDS) {
+        primitives.emplace_back(rwlock_kind_name(kind) + "_r90",
+                                [kind](int t, int i, const WorkloadConfig&) {
+            return test_rwlock(t, i, 90, kind);
+        });
+    }
+    for (CounterKind kind : ALL_COUNTER_KINDS) {
+        primitives.emplace_back(counter_kind_name(kind), [kind](int t, int i, const WorkloadConfig&) {
+            test_counter(t, i, kind);
+            return LatencyHistogram();
+        });
+    }
+    
+    vector<string> names;
+    vector<vector<double>> ops_per_second;
+    vector<pair<string, double>> sweep_results;
+    vector<LatencyHistogram> sweep_latencies;
+    vector<PerfSample> sweep_perf;
+    
+    for (const auto& [name, test] : primitives) {
+        cout << "Тестируем: " << name << "...\n";
+        names.push_back(name);
+        ops_per_second.emplace_back();
+        
+        for (int threads : thread_counts) {
+            LatencyHistogram latency = test(threads, iterations, WorkloadConfig{});
+            double time = contended_microseconds();
+            
+            ops_per_second.back().push_back(time > 0 ? threads * iterations / (time / 1e6) : 0.0);
+            sweep_results.emplace_back(name + "_" + to_string(threads) + "t", time);
+            sweep_latencies.push_back(latency);
+            sweep_perf.push_back(contended_perf());
+        }
+    }
+    
+    // Матрица: операций в секунду (млн), ускорение и эффективность относительно 1 потока
+    auto print_matrix = [&](const string& title, auto cell) {
+        cout << "\n" << title << "\n";
+        cout << setw(22) << left << "Примитив";
+        for (int t : thread_counts) {
+            cout << setw(10) << (to_string(t) + "t");
+        }
+        cout << "\n" << string(22 + 10 * thread_counts.size(), '-') << endl;
+        for (size_t p = 0; p < names.size(); ++p) {
+            cout << setw(22) << left << names[p];
+            for (size_t c = 0; c < thread_counts.size(); ++c) {
+                cout << setw(10) << fixed << setprecision(2) << cell(p, c);
+            }
+            cout << endl;
+        }
+    };
+    
+    print_matrix("Млн операций в секунду:", [&](size_t p, size_t c) {
+        return ops_per_second[p][c] / 1e6;
+    });
+    print_matrix("Ускорение (относительно 1 потока):", [&](size_t p, size_t c) {
+        return ops_per_second[p][0] > 0 ? ops_per_second[p][c] / ops_per_second[p][0] : 0.0;
+    });
+    print_matrix("Эффективность (ускорение / число потоков):", [&](size_t p, size_t c) {
+        double speedup = ops_per_second[p][0] > 0 ? ops_per_second[p][c] / ops_per_second[p][0] : 0.0;
+        return speedup / thread_counts[c];
+    });
+    
+    vector<string> columns;
+    for (int t : thread_counts) {
+        columns.push_back(to_string(t) + "t");
+    }
+    Benchmark::save_matrix_to_csv(names, columns, ops_per_second, "contention_matrix.csv");
+    Benchmark::print_perf(sweep_results, sweep_perf);
+    Benchmark::save_to_csv(sweep_results, sweep_latencies, sweep_perf,
+                           "contention_benchmark.csv");
+}
+
+// справедливость: захваты по потокам за фиксированное время
+void run_fairness_benchmark(int num_threads, int duration_ms) {
+    cout << "\n=== Справедливость примитивов ===\n";
+    cout << "Параметры: " << num_threads << " потоков, окно " << duration_ms << " мс\n\n";
+    
+    cout << setw(16) << left << "Примитив"
+              << setw(14) << "Захватов"
+              << setw(12) << "Джайн"
+              << setw(14) << "Мин/поток"
+              << setw(14) << "Макс/поток"
+              << setw(14) << "Макс. серия" << "\n";
+    cout << string(84, '-') << endl;
+    
+    vector<string> names;
+    vector<vector<double>> per_thread;
+    vector<string> columns = {"Всего", "Джайн", "Макс_серия"};
+    for (int i = 0; i < num_threads; ++i) {
+        columns.push_back("Поток_" + to_string(i));
+    }
+    
+    for (const auto& primitive : lock_primitives()) {
+        FairnessStats stats = primitive.fairness(num_threads, duration_ms);
+        auto [min_it, max_it] = minmax_element(stats.acquisitions.begin(),
+                                               stats.acquisitions.end());
+        
+        cout << setw(16) << left << primitive.name
+                  << setw(14) << stats.total
+                  << setw(12) << fixed << setprecision(3) << stats.jain_index
+                  << setw(14) << *min_it
+                  << setw(14) << *max_it
+                  << setw(14) << stats.max_streak << endl;
+        
+        names.push_back(primitive.name);
+        vector<double> row = {static_cast<double>(stats.total), stats.jain_index,
+                              static_cast<double>(stats.max_streak)};
+        for (long long count : stats.acquisitions) {
+            row.push_back(static_cast<double>(count));
+        }
+        per_thread.push_back(row);
+    }
+    cout << string(84, '-') << endl;
+    
+    Benchmark::save_matrix_to_csv(names, columns, per_thread, "fairness_benchmark.csv");
+}
+
+// когортная блокировка против обычных при потоках, разнесенных по NUMA-узлам
+void run_cohort_benchmark() {
+    cout << "\n=== Когортная NUMA-блокировка ===\n";
+    cout << "Топология: " << CpuTopology::instance().summary() << "\n";
+    
+    const int iterations = 2000;
+    int max_threads = max(4, static_cast<int>(thread::hardware_concurrency()));
+    vector<int> thread_counts;
+    for (int t = 2; t <= max_threads; t *= 2) {
+        thread_counts.push_back(t);
+    }
+    
+    // Потоки раскладываем по сокетам по очереди, под блокировкой трогаем несколько общих
+    // кэш-линий: передача между узлами тащит их через межсокетную шину
+    WorkloadConfig workload;
+    workload.placement = PlacementPolicy::SCATTER;
+    workload.shared_lines = 4;
+    workload.critical_work = 50;
+    
+    // На одноузловой машине когорты имитируются: узел = номер потока % nodes
+    vector<pair<string, LockTest>> primitives = {
+        {"Mutex", test_mutex},
+        {"TicketLock", test_ticketlock},
+        {"MCSLock", test_mcslock},
+        {"CohortLock", [](int t, int i, const WorkloadConfig& w) {
+            return test_cohort_lock(t, i, 0, w);
+        }},
+        {"CohortLock_sim2", [](int t, int i, const WorkloadConfig& w) {
+            return test_cohort_lock(t, i, 2, w);
+        }},
+        {"CohortLock_sim4", [](int t, int i, const WorkloadConfig& w) {
+            return test_cohort_lock(t, i, 4, w);
+        }},
+    };
+    
+    cout << "Итераций на поток: " << iterations << ", размещение: "
+         << placement_name(workload.placement) << "\n\n";
+    cout << setw(18) << left << "Примитив";
+    for (int t : thread_counts) {
+        cout << setw(14) << (to_string(t) + " потоков");
+    }
+    cout << "\n" << string(18 + 14 * thread_counts.size(), '-') << endl;
+    
+    vector<pair<string, double>> results;
+    vector<LatencyHistogram> latencies;
+    vector<PerfSample> perf;
+    
+    for (const auto& [name, test] : primitives) {
+        cout << setw(18) << left << name;
+        for (int threads : thread_counts) {
+            latencies.push_back(test(threads, iterations, workload));
+            double time = contended_microseconds();
+            results.emplace_back(name + "_" + to_string(threads) + "t", time);
+            perf.push_back(contended_perf());
+            cout << setw(14) << fixed << setprecision(0) << time;
+        }
+        cout << endl;
+    }
+    cout << "(время, мкс)\n";
+    
+    Benchmark::print_latency(results, latencies);
+    Benchmark::print_perf(results, perf);
+    Benchmark::save_to_csv(results, latencies, perf, "cohort_benchmark.csv");
+}
+
+// пропускная способность читателей при разной частоте записи
+void run_read_path_benchmark() {
+    cout << "\n=== Read-mostly данные: seqlock и RCU против блокировок ===\n";
+    
+    const int duration_ms = 200;
+    int readers = max(2, static_cast<int>(thread::hardware_concurrency()) - 1);
+    // Пауза писателя между записями, мкс (-1 - писатель молчит)
+    vector<pair<string, int>> write_rates = {
+        {"без_записей", -1}, {"100/с", 10000}, {"1k/с", 1000},
+        {"10k/с", 100}, {"100k/с", 10}, {"непрерывно", 0}
+    };
+    
+    cout << "Читателей: " << readers << ", писатель: 1, окно: " << duration_ms << " мс\n";
+    cout << "Пропускная способность читателей, млн чтений/с\n\n";
+    cout << setw(14) << left << "Путь";
+    for (const auto& rate : write_rates) {
+        cout << setw(14) << rate.first;
+    }
+    cout << "\n" << string(14 + 14 * write_rates.size(), '-') << endl;
+    
+    vector<string> names;
+    vector<vector<double>> reads_matrix;
+    long long torn_total = 0;
+    
+    for (ReadPathKind kind : ALL_READ_PATH_KINDS) {
+        names.push_back(read_path_kind_name(kind));
+        reads_matrix.emplace_back();
+        cout << setw(14) << left << read_path_kind_name(kind);
+        for (const auto& rate : write_rates) {
+            ReadPathStats stats = test_read_path(readers, duration_ms, rate.second, kind);
+            reads_matrix.back().push_back(stats.reads_per_second / 1e6);
+            torn_total += stats.torn_reads;
+            cout << setw(14) << fixed << setprecision(3) << stats.reads_per_second / 1e6;
+        }
+        cout << endl;
+    }
+    cout << string(14 + 14 * write_rates.size(), '-') << endl;
+    cout << "Рваных снимков: " << torn_total << (torn_total == 0 ? " (ок)" : " (ОШИБКА)") << "\n";
+    
+    vector<string> columns;
+    for (const auto& rate : write_rates) {
+        columns.push_back(rate.first);
+    }
+    Benchmark::save_matrix_to_csv(names, columns, reads_matrix, "read_path_benchmark.csv");
+}
+
+// flat combining при росте числа потоков
+void run_combining_benchmark() {
+    cout << "\n=== Flat combining против Mutex и SpinLock ===\n";
+    
+    const int iterations = 20000;
+    int max_threads = max(16, 2 * static_cast<int>(thread::hardware_concurrency()));
+    vector<int> thread_counts;
+    for (int t = 1; t <= max_threads; t *= 2) {
+        thread_counts.push_back(t);
+    }
+    
+    cout << "Итераций на поток: " << iterations << "\n";
+    
+    vector<pair<string, double>> results;
+    vector<LatencyHistogram> latencies;
+    vector<PerfSample> perf;
+    
+    for (CombiningStructure structure : ALL_COMBINING_STRUCTURES) {
+        cout << "\n" << combining_structure_name(structure) << ", млн операций/с\n";
+        cout << setw(16) << left << "Синхронизация";
+        for (int t : thread_counts) {
+            cout << setw(10) << (to_string(t) + "t");
+        }
+        cout << "\n" << string(16 + 10 * thread_counts.size(), '-') << endl;
+        
+        for (CombiningSync sync : ALL_COMBINING_SYNCS) {
+            string name = combining_structure_name(structure) + "_" + combining_sync_name(sync);
+            cout << setw(16) << left << combining_sync_name(sync);
+            for (int threads : thread_counts) {
+                latencies.push_back(test_combining(threads, iterations, structure, sync));
+                double time = contended_microseconds();
+                results.emplace_back(name + "_" + to_string(threads) + "t", time);
+                perf.push_back(contended_perf());
+                double mops = time > 0 ? threads * iterations / time : 0.0;
+                cout << setw(10) << fixed << setprecision(2) << mops;
+            }
+            cout << endl;
+        }
+    }
+    
+    Benchmark::print_latency(results, latencies, "Задержка операции (нс)");
+    Benchmark::save_to_csv(results, latencies, perf, "combining_benchmark.csv");
+}
+
+// производители/потребители при разных соотношениях
+void run_queue_benchmark() {
+    cout << "\n=== Очереди производитель/потребитель ===\n";
+    
+    vector<pair<int, int>> ratios = {{1, 1}, {1, 4}, {4, 1}, {2, 2}, {4, 4}};
+    const int messages_per_producer = 20000;
+    
+    cout << "Сообщений на производителя: " << messages_per_producer << "\n\n";
+    cout << setw(14) << left << "Очередь"
+              << setw(10) << "П:П"
+              << setw(16) << "Сообщ/с"
+              << setw(12) << "p50 (нс)"
+              << setw(12) << "p99 (нс)" << "\n";
+    cout << string(64, '-') << endl;
+    
+    vector<pair<string, double>> queue_results;
+    vector<LatencyHistogram> queue_latencies;
+    
+    for (const auto& [producers, consumers] : ratios) {
+        for (QueueKind kind : ALL_QUEUE_KINDS) {
+            QueueStats stats = test_queue(producers, consumers, messages_per_producer, kind);
+            string ratio = to_string(producers) + ":" + to_string(consumers);
+            
+            cout << setw(14) << left << queue_kind_name(kind)
+                      << setw(10) << ratio
+                      << setw(16) << fixed << setprecision(0) << stats.messages_per_second
+                      << setw(12) << stats.handoff_latency.percentile(50)
+                      << setw(12) << stats.handoff_latency.percentile(99) << endl;
+            
+            queue_results.emplace_back(
+                queue_kind_name(kind) + "_" + to_string(producers) + "p" +
+                to_string(consumers) + "c",
+                stats.elapsed_us
+            );
+            queue_latencies.push_back(stats.handoff_latency);
+        }
+    }
+    cout << string(64, '-') << endl;
+    
+    Benchmark::save_to_csv(queue_results, queue_latencies, "queue_benchmark.csv");
+}
+
 // основная
 void run_race() {
     cout << "\n=== Задание 1: Параллельная гонка с ASCII символами ===\n";
-    cout << "Сравнение 6 примитивов синхронизации:\n";
+    cout << "Сравнение 13 примитивов синхронизации:\n";
     cout << "1. Mutex (взаимное исключение)\n";
     cout << "2. Semaphore (семафор)\n";
-    cout << "3. Barrier (барьер)\n";
+    cout << "3. Barrier (барьер: condvar, sense-reversing, дерево, диссеминация)\n";
     cout << "4. SpinLock (спин-блокировка)\n";
     cout << "5. SpinWait (ожидание с уступкой)\n";
-    cout << "6. Monitor (монитор)\n\n";
+    cout << "6. Monitor (монитор)\n";
+    cout << "7. TicketLock (блокировка по билетам)\n";
+    cout << "8. MCSLock (очередь MCS)\n";
+    cout << "9. CLHLock (очередь CLH)\n";
+    cout << "10. AdaptiveMutex (спин, затем futex)\n";
+    cout << "11. FastSemaphore (семафор с быстрым путем на атомике)\n";
+    cout << "12. RW-блокировки (shared_mutex, приоритет писателя, big-reader)\n";
+    cout << "13. CohortLock (когортная блокировка для NUMA)\n";
+    cout << "+ seqlock и RCU на эпохах для read-mostly данных\n";
+    cout << "+ стандартные C++20: counting/binary_semaphore, barrier, latch, atomic::wait\n";
+    cout << "+ flat combining для горячих критических секций\n";
+    cout << "+ счетчики без блокировки (fetch_add, по потокам, полосатый)\n\n";
     
     int choice;
     cout << "Выберите режим тестирования:\n";
     cout << "1. Стандартный тест (все примитивы с заданными параметрами)\n";
     cout << "2. Тест масштабируемости\n";
     cout << "3. Расширенный бенчмарк\n";
+    cout << "4. Сравнение барьеров\n";
+    cout << "5. Зависимость от длины критической секции\n";
+    cout << "6. Очереди производитель/потребитель\n";
+    cout << "7. Все примитивы по числу потоков (до 4x hardware_concurrency)\n";
+    cout << "8. Справедливость (захваты по потокам, индекс Джайна)\n";
+    cout << "9. Когортная NUMA-блокировка (реальные и симулированные узлы)\n";
+    cout << "10. Read-mostly данные: seqlock и RCU против Mutex/Monitor\n";
+    cout << "11. Flat combining против Mutex/SpinLock (счетчик, очередь с приоритетом)\n";
+    cout << "12. Режим по времени: операций в секунду за заданное окно\n";
     cout << "Ваш выбор: ";
     cin >> choice;
     
@@ -511,6 +2669,51 @@ void run_race() {
         case 3:
             run_extended_benchmark();
             break;
+        case 4:
+            run_barrier_benchmark();
+            break;
+        case 5:
+            run_workload_sweep();
+            break;
+        case 6:
+            run_queue_benchmark();
+            break;
+        case 7:
+            run_contention_sweep();
+            break;
+        case 8:
+            run_fairness_benchmark(4, 200);
+            break;
+        case 9:
+            run_cohort_benchmark();
+            break;
+        case 10:
+            run_read_path_benchmark();
+            break;
+        case 11:
+            run_combining_benchmark();
+            break;
+        case 12: {
+            int num_threads, seconds;
+            WorkloadConfig workload;
+            
+            cout << "\nВведите количество потоков (1-16): ";
+            cin >> num_threads;
+            
+            cout << "Введите длительность окна в секундах (1-60): ";
+            cin >> seconds;
+            
+            if (num_threads < 1 || num_threads > 16 || seconds < 1 || seconds > 60) {
+                cout << "Некорректные параметры! Использую значения по умолчанию.\n";
+                num_threads = 4;
+                seconds = 1;
+            }
+            
+            workload.duration_ms = seconds * 1000;
+            workload.warmup_ms = THROUGHPUT_DEFAULT_WARMUP_MS;
+            benchmark_all_primitives(num_threads, 0, workload);
+            break;
+        }
         default:
             cout << "Неверный выбор! Запускаю стандартный тест...\n";
             benchmark_all_primitives(4, 1000);
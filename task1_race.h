@@ -3,27 +3,250 @@
 
 #include <vector>
 #include <string>
+#include "topology.h"
+#include "benchmark_utils.h"
 
 namespace task1 {
     
+    // Сколько попыток AdaptiveMutex крутится в спине, прежде чем уснуть на futex
+    constexpr int ADAPTIVE_DEFAULT_SPINS = 100;
+    
+    // Сколько раз подряд CohortLock передает блокировку внутри NUMA-узла
+    constexpr int COHORT_DEFAULT_BATCH = 64;
+    
+    // Прогрев перед окном замера в режиме по времени (кэши, частота CPU, futex-очереди)
+    constexpr int THROUGHPUT_DEFAULT_WARMUP_MS = 200;
+    
+    // Реализации барьера для test_barrier
+    enum class BarrierKind {
+        CONDVAR,        // мьютекс + condition_variable
+        SENSE,          // централизованный sense-reversing (спин)
+        TREE,           // комбинирующее дерево
+        DISSEMINATION,  // диссеминационный
+        STD_BARRIER,    // std::barrier (C++20)
+        STD_LATCH       // одноразовые std::latch, по одной на раунд (C++20)
+    };
+    
+    constexpr BarrierKind ALL_BARRIER_KINDS[] = {
+        BarrierKind::CONDVAR, BarrierKind::SENSE,
+        BarrierKind::TREE, BarrierKind::DISSEMINATION,
+        BarrierKind::STD_BARRIER, BarrierKind::STD_LATCH
+    };
+    
+    std::string barrier_kind_name(BarrierKind kind);
+    
+    // Реализации RW-блокировки для test_rwlock
+    enum class RWLockKind {
+        MUTEX,              // std::mutex, читатели тоже эксклюзивно (базовая линия)
+        SHARED_MUTEX,       // std::shared_mutex
+        WRITER_PREFERRING,  // приоритет писателя
+        BIG_READER          // счетчик читателей на каждое ядро
+    };
+    
+    constexpr RWLockKind ALL_RWLOCK_KINDS[] = {
+        RWLockKind::MUTEX, RWLockKind::SHARED_MUTEX,
+        RWLockKind::WRITER_PREFERRING, RWLockKind::BIG_READER
+    };
+    
+    std::string rwlock_kind_name(RWLockKind kind);
+    
+    // Стратегии агрегации счетчика без блокировки для test_counter
+    enum class CounterKind {
+        FETCH_ADD,   // один общий atomic, fetch_add
+        PER_THREAD,  // слот на поток (по кэш-линии), сводка после join
+        STRIPED      // полосатый счетчик: несколько атомиков по кэш-линиям
+    };
+    
+    constexpr CounterKind ALL_COUNTER_KINDS[] = {
+        CounterKind::FETCH_ADD, CounterKind::PER_THREAD, CounterKind::STRIPED
+    };
+    
+    std::string counter_kind_name(CounterKind kind);
+    
+    // Общая структура и способ синхронизации для test_combining
+    enum class CombiningStructure {
+        COUNTER,         // счетчик, как в test_* (операция в пару инструкций)
+        PRIORITY_QUEUE   // маленькая std::priority_queue (push + pop сверх лимита)
+    };
+    
+    constexpr CombiningStructure ALL_COMBINING_STRUCTURES[] = {
+        CombiningStructure::COUNTER, CombiningStructure::PRIORITY_QUEUE
+    };
+    
+    enum class CombiningSync {
+        MUTEX,           // std::mutex
+        SPINLOCK,        // SpinLock
+        FLAT_COMBINING   // операции выполняет текущий владелец пачкой
+    };
+    
+    constexpr CombiningSync ALL_COMBINING_SYNCS[] = {
+        CombiningSync::MUTEX, CombiningSync::SPINLOCK, CombiningSync::FLAT_COMBINING
+    };
+    
+    std::string combining_structure_name(CombiningStructure structure);
+    std::string combining_sync_name(CombiningSync sync);
+    
+    // Реализации очереди для test_queue
+    enum class QueueKind {
+        MUTEX_QUEUE,  // std::mutex + std::queue
+        MPMC_RING     // lock-free кольцо с номерами последовательности в ячейках
+    };
+    
+    constexpr QueueKind ALL_QUEUE_KINDS[] = {QueueKind::MUTEX_QUEUE, QueueKind::MPMC_RING};
+    
+    std::string queue_kind_name(QueueKind kind);
+    
+    // Пути чтения read-mostly данных для test_read_path
+    enum class ReadPathKind {
+        MUTEX,    // std::mutex, читатели тоже захватывают
+        MONITOR,  // Monitor
+        SEQLOCK,  // seqlock: читатель повторяет копию при записи
+        RCU       // RCU на эпохах: читатель пишет только свой слот
+    };
+    
+    constexpr ReadPathKind ALL_READ_PATH_KINDS[] = {
+        ReadPathKind::MUTEX, ReadPathKind::MONITOR, ReadPathKind::SEQLOCK, ReadPathKind::RCU
+    };
+    
+    std::string read_path_kind_name(ReadPathKind kind);
+    
+    // Результат read-mostly теста
+    struct ReadPathStats {
+        double reads_per_second = 0.0;
+        long long writes = 0;
+        long long torn_reads = 0;  // несогласованных снимков (должно быть 0)
+    };
+    
+    // Результат теста очереди
+    struct QueueStats {
+        double elapsed_us = 0.0;
+        double messages_per_second = 0.0;
+        LatencyHistogram handoff_latency;  // от постановки до извлечения, нс
+    };
+    
+    // Справедливость блокировки за фиксированное окно времени
+    struct FairnessStats {
+        std::vector<long long> acquisitions;  // захватов на каждый поток
+        long long total = 0;
+        double jain_index = 0.0;              // (sum x)^2 / (n * sum x^2), 1 - идеально
+        long long max_streak = 0;             // макс. захватов подряд одним владельцем
+    };
+    
+    // Параметры нагрузки для тестов взаимного исключения (работа в единицах ~1 нс)
+    struct WorkloadConfig {
+        int critical_work = 0;  // работа внутри критической секции
+        int shared_lines = 0;   // сколько кэш-линий общих данных трогаем под блокировкой
+        int outside_work = 0;   // работа между захватами
+        PlacementPolicy placement = PlacementPolicy::NONE;  // привязка потоков к CPU
+        int duration_ms = 0;    // > 0 - режим по времени: iterations не используется
+        int warmup_ms = 0;      // прогрев перед окном замера в режиме по времени
+    };
+    
+    // Пропускная способность последнего теста взаимного исключения
+    struct ThroughputStats {
+        std::vector<double> thread_ops_per_second;  // операций в секунду на каждый поток
+        long long total_ops = 0;
+        double seconds = 0.0;                       // длина окна замера
+        double ops_per_second = 0.0;
+        PerfSample perf;                            // счетчики perf за окно замера
+    };
+    
     // Основные тесты
     void run_race();
     void run_extended_benchmark();
     
     // Тесты примитивов синхронизации
-    void test_mutex(int num_threads, int iterations);
-    void test_semaphore(int num_threads, int iterations);
-    void test_barrier(int num_threads, int iterations);
-    void test_spinlock(int num_threads, int iterations);
-    void test_spinwait(int num_threads, int iterations);
-    void test_monitor(int num_threads, int iterations);
+    LatencyHistogram test_mutex(int num_threads, int iterations,
+                                const WorkloadConfig& workload = {});
+    LatencyHistogram test_semaphore(int num_threads, int iterations,
+                                    const WorkloadConfig& workload = {});
+    LatencyHistogram test_fast_semaphore(int num_threads, int iterations,
+                                         const WorkloadConfig& workload = {});
+    LatencyHistogram test_barrier(int num_threads, int iterations,
+                                  BarrierKind kind = BarrierKind::CONDVAR);
+    LatencyHistogram test_spinlock(int num_threads, int iterations,
+                                   const WorkloadConfig& workload = {});
+    LatencyHistogram test_spinwait(int num_threads, int iterations,
+                                   const WorkloadConfig& workload = {});
+    LatencyHistogram test_monitor(int num_threads, int iterations,
+                                  const WorkloadConfig& workload = {});
+    
+    // Счетчики без блокировки (та же нагрузка, что и в test_*)
+    void test_counter(int num_threads, int iterations, CounterKind kind);
+    
+    // RW-блокировки: read_percent - доля операций чтения (0-100)
+    LatencyHistogram test_rwlock(int num_threads, int iterations, int read_percent,
+                                 RWLockKind kind = RWLockKind::SHARED_MUTEX);
+    
+    // Очереди блокировок (каждый ждущий крутится на своей кэш-линии)
+    LatencyHistogram test_ticketlock(int num_threads, int iterations,
+                                     const WorkloadConfig& workload = {});
+    LatencyHistogram test_mcslock(int num_threads, int iterations,
+                                  const WorkloadConfig& workload = {});
+    LatencyHistogram test_clhlock(int num_threads, int iterations,
+                                  const WorkloadConfig& workload = {});
+    
+    // Адаптивный мьютекс: спин ограниченной длины, затем сон на futex
+    LatencyHistogram test_adaptive_mutex(int num_threads, int iterations,
+                                         int spin_limit = ADAPTIVE_DEFAULT_SPINS,
+                                         const WorkloadConfig& workload = {});
+    
+    // Стандартные примитивы C++20 в роли блокировки: std::counting_semaphore,
+    // std::binary_semaphore и мьютекс на std::atomic<int>::wait/notify_one
+    LatencyHistogram test_std_counting_semaphore(int num_threads, int iterations,
+                                                 const WorkloadConfig& workload = {});
+    LatencyHistogram test_std_binary_semaphore(int num_threads, int iterations,
+                                               const WorkloadConfig& workload = {});
+    LatencyHistogram test_atomic_wait_lock(int num_threads, int iterations,
+                                           const WorkloadConfig& workload = {});
+    
+    // Когортная NUMA-блокировка: simulated_nodes > 0 - узел по номеру потока, а не по CPU
+    LatencyHistogram test_cohort_lock(int num_threads, int iterations, int simulated_nodes = 0,
+                                      const WorkloadConfig& workload = {});
+    
+    // Производители/потребители: messages_per_producer сообщений от каждого производителя
+    QueueStats test_queue(int producers, int consumers, int messages_per_producer,
+                          QueueKind kind);
+    
+    // Операции над общей структурой: обычная блокировка или flat combining
+    LatencyHistogram test_combining(int num_threads, int iterations,
+                                    CombiningStructure structure, CombiningSync sync);
+    
+    // Read-mostly: readers читателей и один писатель с паузой write_interval_us (-1 - без записей)
+    ReadPathStats test_read_path(int readers, int duration_ms, int write_interval_us,
+                                 ReadPathKind kind);
     
     // Бенчмарк всех примитивов
-    void benchmark_all_primitives(int num_threads, int iterations);
+    void benchmark_all_primitives(int num_threads, int iterations,
+                                  const WorkloadConfig& workload = {});
     
     // Расширенный бенчмарк с разными параметрами
     void run_scalability_test();
     
+    // Сравнение реализаций барьера по количеству потоков
+    void run_barrier_benchmark();
+    
+    // Сравнение примитивов при разной длине критической секции
+    void run_workload_sweep();
+    
+    // Очереди при разных соотношениях производителей и потребителей
+    void run_queue_benchmark();
+    
+    // Все примитивы от 1 потока до hardware_concurrency и переподписки x2, x4
+    void run_contention_sweep();
+    
+    // Справедливость всех блокировок: захваты по потокам за duration_ms
+    void run_fairness_benchmark(int num_threads, int duration_ms);
+    
+    // Когортная блокировка против Mutex/TicketLock/MCSLock, потоки разнесены по узлам
+    void run_cohort_benchmark();
+    
+    // Seqlock и RCU против Mutex/Monitor при разной частоте записи
+    void run_read_path_benchmark();
+    
+    // Flat combining против Mutex/SpinLock при росте числа потоков
+    void run_combining_benchmark();
+    
 } 
 
 #endif 
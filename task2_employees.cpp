@@ -1,24 +1,77 @@
 #include "task2_employees.h"
 #include "benchmark_utils.h"
+#include "fast_random.h"
+#include "worker_pool.h"
+#include "simd_kernels.h"
+#include "parallel_reduce.h"
 #include <iostream>
 #include <thread>
 #include <vector>
-#include <random>
 #include <algorithm>
 #include <mutex>
 #include <iomanip>
 #include <cmath>
 #include <sstream>
+#include <array>
+#include <type_traits>
 
 using namespace std;
 namespace task2 {
 
 
-// Генерация сотрудников	
-vector<Employee> generate_employees(int count, const string& target_position) {
-    vector<Employee> employees;
-    random_device rd;
-    mt19937 gen(rd());
+string query_kind_name(QueryKind kind) {
+    switch (kind) {
+        case QueryKind::PASSES: return "проходы";
+        case QueryKind::FUSED: return "один_проход";
+        case QueryKind::SIMD: return "векторный";
+    }
+    return "проходы";
+}
+
+// Словарь должностей
+int EmployeeTable::find_position(const string& position) const {
+    auto it = find(positions.begin(), positions.end(), position);
+    return it == positions.end() ? -1 : static_cast<int>(it - positions.begin());
+}
+
+int EmployeeTable::encode_position(const string& position) {
+    int id = find_position(position);
+    if (id >= 0) {
+        return id;
+    }
+    positions.push_back(position);
+    return static_cast<int>(positions.size()) - 1;
+}
+
+void EmployeeTable::push_back(const Employee& employee) {
+    names.push_back(employee.name);
+    position_ids.push_back(encode_position(employee.position));
+    ages.push_back(employee.age);
+    salaries.push_back(employee.salary);
+}
+
+Employee EmployeeTable::row(size_t i) const {
+    return Employee(names[i], positions[position_ids[i]], ages[i], salaries[i]);
+}
+
+EmployeeTable EmployeeTable::from_rows(const vector<Employee>& employees) {
+    EmployeeTable table;
+    table.names.reserve(employees.size());
+    table.position_ids.reserve(employees.size());
+    table.ages.reserve(employees.size());
+    table.salaries.reserve(employees.size());
+    for (const auto& emp : employees) {
+        table.push_back(emp);
+    }
+    return table;
+}
+
+// Генерация сотрудников: sink(ФИО, номер должности в positions, возраст, зарплата).
+// Порядок вызовов RNG общий для строк и столбцов, поэтому данные совпадают
+template <typename Sink>
+static void generate_rows(int count, const vector<string>& positions, Sink&& sink) {
+    // Один seed - один и тот же набор данных, прогоны сравнимы между собой
+    Xoshiro256 rng(benchmark_seed());
     
     // Списки для генерации данных
     vector<string> first_names = {"Иван", "Петр", "Сергей", "Алексей", "Дмитрий", 
@@ -29,31 +82,38 @@ vector<Employee> generate_employees(int count, const string& target_position) {
                                             "Дмитриевич", "Ивановна", "Петровна", "Сергеевна", 
                                             "Алексеевна", "Дмитриевна"};
     
-    vector<string> positions = {"Менеджер", "Разработчик", "Аналитик", "Тестировщик", 
-                                         "Дизайнер", "Администратор", "Бухгалтер", target_position};
-    // Диапазоны всего
-    uniform_int_distribution<> age_dist(20, 65);
-    uniform_real_distribution<> salary_dist(30000, 300000);
-    uniform_int_distribution<> position_dist(0, positions.size() - 1);
-    
     for (int i = 0; i < count; ++i) {
         // Генерация ФИО
         ostringstream name;
-        name << last_names[gen() % last_names.size()] << " "
-             << first_names[gen() % first_names.size()] << " "
-             << middle_names[gen() % middle_names.size()];
+        name << last_names[rng.below(last_names.size())] << " "
+             << first_names[rng.below(first_names.size())] << " "
+             << middle_names[rng.below(middle_names.size())];
         
         // Генерация должности
-        string position = positions[position_dist(gen)];
+        int position = static_cast<int>(rng.below(positions.size()));
         
         // Генерация возраста
-        int age = age_dist(gen);
+        int age = rng.uniform(MIN_EMPLOYEE_AGE, MAX_EMPLOYEE_AGE);
         
         // Генерация зарплаты
-        double salary = salary_dist(gen);
+        double salary = rng.uniform_real(30000, 300000);
         
-        employees.emplace_back(name.str(), position, age, salary);
+        sink(name.str(), position, age, salary);
     }
+}
+
+static vector<string> generated_positions(const string& target_position) {
+    return {"Менеджер", "Разработчик", "Аналитик", "Тестировщик", 
+            "Дизайнер", "Администратор", "Бухгалтер", target_position};
+}
+
+vector<Employee> generate_employees(int count, const string& target_position) {
+    vector<Employee> employees;
+    vector<string> positions = generated_positions(target_position);
+    
+    generate_rows(count, positions, [&](string name, int position, int age, double salary) {
+        employees.emplace_back(move(name), positions[position], age, salary);
+    });
     
     // Проверка сотрудников с целевой должностью
     bool has_target_position = false;
@@ -71,6 +131,37 @@ vector<Employee> generate_employees(int count, const string& target_position) {
     return employees;
 }
 
+EmployeeTable generate_employee_table(int count, const string& target_position) {
+    EmployeeTable table;
+    vector<string> positions = generated_positions(target_position);
+    // Словарь в порядке списка должностей; целевая может совпасть с одной из них
+    vector<int> ids;
+    for (const auto& position : positions) {
+        ids.push_back(table.encode_position(position));
+    }
+    
+    table.names.reserve(count);
+    table.position_ids.reserve(count);
+    table.ages.reserve(count);
+    table.salaries.reserve(count);
+    generate_rows(count, positions, [&](string name, int position, int age, double salary) {
+        table.names.push_back(move(name));
+        table.position_ids.push_back(ids[position]);
+        table.ages.push_back(age);
+        table.salaries.push_back(salary);
+    });
+    
+    // Как и в generate_employees: целевая должность есть хотя бы у первого сотрудника
+    int target_id = table.find_position(target_position);
+    if (!table.position_ids.empty() &&
+        find(table.position_ids.begin(), table.position_ids.end(), target_id) ==
+            table.position_ids.end()) {
+        table.position_ids[0] = target_id;
+    }
+    
+    return table;
+}
+
 // Расчет среднего возраста
 double calculate_average_age(const vector<Employee>& employees, const string& target_position) {
     double total_age = 0.0;
@@ -86,6 +177,22 @@ double calculate_average_age(const vector<Employee>& employees, const string& ta
     return count > 0 ? total_age / count : 0.0;
 }
 
+// По столбцам: сравнение номеров должностей, читаются только должность и возраст
+double calculate_average_age(const EmployeeTable& table, const string& target_position) {
+    int target_id = table.find_position(target_position);
+    long long total_age = 0;
+    int count = 0;
+    
+    for (size_t j = 0; j < table.size(); ++j) {
+        if (table.position_ids[j] == target_id) {
+            total_age += table.ages[j];
+            count++;
+        }
+    }
+    
+    return count > 0 ? static_cast<double>(total_age) / count : 0.0;
+}
+
 // Поиск максимальной зп у среднего возраста
 double find_max_salary_near_average(const vector<Employee>& employees, 
                                    const string& target_position, 
@@ -105,140 +212,566 @@ double find_max_salary_near_average(const vector<Employee>& employees,
     return max_salary;
 }
 
-// Однопоточная обработка(просто применение всего)
-void process_single_thread(const vector<Employee>& employees, 
-                          const string& target_position) {
+double find_max_salary_near_average(const EmployeeTable& table, 
+                                   const string& target_position, 
+                                   double average_age, 
+                                   int age_range) {
+    int target_id = table.find_position(target_position);
+    double max_salary = 0.0;
+    
+    for (size_t j = 0; j < table.size(); ++j) {
+        if (table.position_ids[j] == target_id && 
+            abs(table.ages[j] - average_age) <= age_range) {
+            if (table.salaries[j] > max_salary) {
+                max_salary = table.salaries[j];
+            }
+        }
+    }
+    
+    return max_salary;
+}
+
+// Однопоточный запрос(просто применение всего)
+QueryResult query_single_thread(const vector<Employee>& employees, 
+                                const string& target_position) {
+    QueryResult result;
+    
     // Расчет среднего возраста
-    double average_age = calculate_average_age(employees, target_position);
+    result.average_age = calculate_average_age(employees, target_position);
     
     // Поиск максимальной зарплаты
-    double max_salary = find_max_salary_near_average(employees, target_position, average_age);
+    result.max_salary = find_max_salary_near_average(employees, target_position, result.average_age);
     
     // Подсчет количества сотрудников с целевой должностью
-    int target_count = 0;
     for (const auto& emp : employees) {
         if (emp.position == target_position) {
-            target_count++;
+            result.target_count++;
         }
     }
     
-    cout << "\n=== Результаты обработки (однопоток) ===\n";
-    cout << "Всего сотрудников: " << employees.size() << "\n";
-    cout << "Сотрудников с должностью '" << target_position << "': " << target_count << "\n\n";
+    return result;
+}
+
+QueryResult query_single_thread(const EmployeeTable& table, 
+                                const string& target_position) {
+    QueryResult result;
+    int target_id = table.find_position(target_position);
     
-    if (target_count > 0) {
-        cout << "Средний возраст: " << fixed << setprecision(2) << average_age << " лет\n";
-        cout << "Максимальная зарплата среди сотрудников\n";
-        cout << "с возрастом +-2 года от среднего: " 
-                  << fixed << setprecision(2) << max_salary << " руб.\n";
-    } else {
-        cout << "Нет сотрудников с должностью '" << target_position << "'\n";
-    }
+    result.average_age = calculate_average_age(table, target_position);
+    result.max_salary = find_max_salary_near_average(table, target_position, result.average_age);
+    
+    // Подсчет читает только столбец должностей
+    result.target_count = static_cast<int>(count(table.position_ids.begin(),
+                                                 table.position_ids.end(), target_id));
+    
+    return result;
 }
 
-// Многопоток
-void process_multi_thread(const vector<Employee>& employees, 
-                         const string& target_position, 
-                         int num_threads) {
-    if (employees.empty()) {
-        cout << "Нет данных для обработки\n";
+// Учет работы потоков последнего прохода планировщика
+static void add_thread_work(ThreadWork* work, int num_threads) {
+    if (work == nullptr) {
         return;
     }
+    work->busy_us.resize(num_threads, 0.0);
+    work->rows.resize(num_threads, 0);
+    const auto& stats = WorkStealingScheduler::instance().last_stats();
+    for (int i = 0; i < num_threads && i < static_cast<int>(stats.size()); ++i) {
+        work->busy_us[i] += stats[i].busy_us;
+        work->rows[i] += stats[i].items;
+        work->steals += stats[i].steals;
+    }
+}
+
+// Параллельная свертка по [0, total): map(acc, begin, end) для каждого куска, затем
+// combine по аккумуляторам потоков. Куски мелкие, свободные потоки крадут их у занятых,
+// поэтому медленное ядро не задерживает весь запрос
+template <typename Acc, typename Map, typename Combine>
+static Acc reduce_scan(size_t total, int num_threads, ThreadWork* work,
+                       Map&& map, Combine&& combine, const Acc& identity = Acc{}) {
+    Acc result = parallel_reduce<Acc>(ReduceRange{total, num_threads, 0}, map, combine, identity);
+    add_thread_work(work, num_threads);
+    return result;
+}
+
+static void combine_age_sum(AgeSum& into, const AgeSum& from) {
+    into.count += from.count;
+    into.sum += from.sum;
+}
+
+static void combine_max(double& into, const double& from) {
+    into = max(into, from);
+}
+
+// Многопоточный запрос над любым представлением: is_target(j), age(j), salary(j) -
+// доступ к строке j. Две фазы: сумма возрастов, затем максимум зарплаты
+template <typename IsTarget, typename Age, typename Salary>
+static QueryResult query_multi_thread_impl(size_t total, int num_threads, ThreadWork* work,
+                                           IsTarget is_target, Age age, Salary salary) {
+    QueryResult result;
+    if (total == 0) {
+        return result;
+    }
     
-    // Генерация потоков
-    vector<thread> threads;
-    vector<double> thread_ages(num_threads, 0.0);
-    vector<int> thread_counts(num_threads, 0);
-    vector<double> thread_max_salaries(num_threads, 0.0);
+    // Первая фаза: число сотрудников должности и сумма их возрастов
+    AgeSum ages = reduce_scan<AgeSum>(total, num_threads, work,
+        [&](AgeSum& acc, size_t start, size_t end) {
+            for (size_t j = start; j < end; ++j) {
+                if (is_target(j)) {
+                    acc.count++;
+                    acc.sum += age(j);
+                }
+            }
+        }, combine_age_sum);
     
-    // Разбивка данных на чанки
-    int chunk_size = employees.size() / num_threads;
-    mutex cout_mutex;
+    result.target_count = static_cast<int>(ages.count);
+    result.average_age = ages.count > 0 ? static_cast<double>(ages.sum) / ages.count : 0.0;
+    double average_age = result.average_age;
     
-    // Потоки параллельно работают с данными
-    for (int i = 0; i < num_threads; ++i) {
-        threads.emplace_back([&, i]() {
-            int start = i * chunk_size;
-            int end = (i == num_threads - 1) ? employees.size() : start + chunk_size;
-            
-            for (int j = start; j < end; ++j) {
-                const auto& emp = employees[j];
-                if (emp.position == target_position) {
-                    thread_ages[i] += emp.age;
-                    thread_counts[i]++;
-                    
-                    // Пока не знаем средний возраст(все потоки еще не отработали), сохраняем максимальную зарплату
-                    if (emp.salary > thread_max_salaries[i]) {
-                        thread_max_salaries[i] = emp.salary;
-                    }
+    // Вторая фаза: поиск максимальной зарплаты с учетом среднего возраста(повторно проходимся по данным).
+    // Те же воркеры и очереди планировщика, без повторного создания потоков
+    result.max_salary = reduce_scan<double>(total, num_threads, work,
+        [&](double& acc, size_t start, size_t end) {
+            for (size_t j = start; j < end; ++j) {
+                if (is_target(j) && abs(age(j) - average_age) <= 2 && salary(j) > acc) {
+                    acc = salary(j);
                 }
             }
-        });
-    }
-    // Синхроним джойном
-    for (auto& t : threads) {
-        t.join();
-    }
+        }, combine_max, 0.0);
     
-    // Собрали результаты
-    double total_age = 0.0;
-    int total_count = 0;
+    return result;
+}
+
+// Многопоточный запрос
+QueryResult query_multi_thread(const vector<Employee>& employees, 
+                               const string& target_position, 
+                               int num_threads,
+                               ThreadWork* work) {
+    return query_multi_thread_impl(
+        employees.size(), num_threads, work,
+        [&](int j) { return employees[j].position == target_position; },
+        [&](int j) { return employees[j].age; },
+        [&](int j) { return employees[j].salary; });
+}
+
+QueryResult query_multi_thread(const EmployeeTable& table, 
+                               const string& target_position, 
+                               int num_threads,
+                               ThreadWork* work) {
+    int target_id = table.find_position(target_position);
+    const int* position_ids = table.position_ids.data();
+    const int* ages = table.ages.data();
+    const double* salaries = table.salaries.data();
+    return query_multi_thread_impl(
+        table.size(), num_threads, work,
+        [=](int j) { return position_ids[j] == target_id; },
+        [=](int j) { return ages[j]; },
+        [=](int j) { return salaries[j]; });
+}
+
+constexpr int AGE_BUCKETS = MAX_EMPLOYEE_AGE - MIN_EMPLOYEE_AGE + 1;
+
+// Корзины по возрастам для однопроходного запроса: 46 счетчиков и максимумов вместо
+// второго прохода по данным. Каждый поток заполняет свои корзины, потом они сливаются
+struct AgeBuckets {
+    array<long long, AGE_BUCKETS> counts{};
+    array<double, AGE_BUCKETS> max_salary{};
+    long long outside = 0;   // возраст вне диапазона - ответ по корзинам будет неверным
     
-    for (int i = 0; i < num_threads; ++i) {
-        total_age += thread_ages[i];
-        total_count += thread_counts[i];
+    void add(int age, double salary) {
+        unsigned bucket = static_cast<unsigned>(age - MIN_EMPLOYEE_AGE);
+        if (bucket >= static_cast<unsigned>(AGE_BUCKETS)) {
+            outside++;
+            return;
+        }
+        counts[bucket]++;
+        if (salary > max_salary[bucket]) {
+            max_salary[bucket] = salary;
+        }
     }
     
-    double average_age = total_count > 0 ? total_age / total_count : 0.0;
+    void merge(const AgeBuckets& other) {
+        for (int b = 0; b < AGE_BUCKETS; ++b) {
+            counts[b] += other.counts[b];
+            max_salary[b] = max(max_salary[b], other.max_salary[b]);
+        }
+        outside += other.outside;
+    }
     
-    // Вторая фаза: поиск максимальной зарплаты с учетом среднего возраста(повторно проходимся по данным)
+    // Средний возраст по счетчикам, максимум зарплаты по корзинам в пределах age_range
+    QueryResult finish(int age_range = 2) const {
+        QueryResult result;
+        long long total_age = 0;
+        long long total_count = 0;
+        for (int b = 0; b < AGE_BUCKETS; ++b) {
+            total_age += static_cast<long long>(MIN_EMPLOYEE_AGE + b) * counts[b];
+            total_count += counts[b];
+        }
+        result.target_count = static_cast<int>(total_count);
+        result.average_age = total_count > 0 ? static_cast<double>(total_age) / total_count : 0.0;
+        
+        for (int b = 0; b < AGE_BUCKETS; ++b) {
+            if (counts[b] > 0 && abs(MIN_EMPLOYEE_AGE + b - result.average_age) <= age_range) {
+                result.max_salary = max(result.max_salary, max_salary[b]);
+            }
+        }
+        return result;
+    }
+};
+
+// Корзины строк [start, end)
+template <typename IsTarget, typename Age, typename Salary>
+static void fill_age_buckets(AgeBuckets& buckets, size_t start, size_t end,
+                             IsTarget is_target, Age age, Salary salary) {
+    for (size_t j = start; j < end; ++j) {
+        if (is_target(j)) {
+            buckets.add(age(j), salary(j));
+        }
+    }
+}
+
+// Один проход: свои корзины у каждого потока, слияние после прохода
+template <typename IsTarget, typename Age, typename Salary>
+static AgeBuckets fused_buckets_multi_thread(size_t total, int num_threads, ThreadWork* work,
+                                             IsTarget is_target, Age age, Salary salary) {
+    return reduce_scan<AgeBuckets>(total, num_threads, work,
+        [&](AgeBuckets& acc, size_t start, size_t end) {
+            fill_age_buckets(acc, start, end, is_target, age, salary);
+        },
+        [](AgeBuckets& into, const AgeBuckets& from) { into.merge(from); });
+}
 
-    threads.clear(); // Стирает потоки которые уже завершились
-    vector<double> thread_phase2_max(num_threads, 0.0);
+QueryResult query_fused_single_thread(const vector<Employee>& employees, 
+                                      const string& target_position) {
+    AgeBuckets buckets;
+    fill_age_buckets(buckets, 0, employees.size(),
+                     [&](size_t j) { return employees[j].position == target_position; },
+                     [&](size_t j) { return employees[j].age; },
+                     [&](size_t j) { return employees[j].salary; });
+    if (buckets.outside > 0) {
+        return query_single_thread(employees, target_position);
+    }
+    return buckets.finish();
+}
+
+QueryResult query_fused_single_thread(const EmployeeTable& table, 
+                                      const string& target_position) {
+    int target_id = table.find_position(target_position);
+    const int* position_ids = table.position_ids.data();
+    const int* ages = table.ages.data();
+    const double* salaries = table.salaries.data();
     
-    for (int i = 0; i < num_threads; ++i) {
-        threads.emplace_back([&, i, average_age]() {
-            int start = i * chunk_size;
-            int end = (i == num_threads - 1) ? employees.size() : start + chunk_size;
-            
-            for (int j = start; j < end; ++j) {
-                const auto& emp = employees[j];
-                if (emp.position == target_position && 
-                    abs(emp.age - average_age) <= 2) {
-                    if (emp.salary > thread_phase2_max[i]) {
-                        thread_phase2_max[i] = emp.salary;
-                    }
-                }
-            }
-        });
+    AgeBuckets buckets;
+    fill_age_buckets(buckets, 0, table.size(),
+                     [=](size_t j) { return position_ids[j] == target_id; },
+                     [=](size_t j) { return ages[j]; },
+                     [=](size_t j) { return salaries[j]; });
+    if (buckets.outside > 0) {
+        return query_single_thread(table, target_position);
+    }
+    return buckets.finish();
+}
+
+QueryResult query_fused_multi_thread(const vector<Employee>& employees, 
+                                     const string& target_position, 
+                                     int num_threads,
+                                     ThreadWork* work) {
+    if (employees.empty()) {
+        return QueryResult{};
+    }
+    AgeBuckets buckets = fused_buckets_multi_thread(
+        employees.size(), num_threads, work,
+        [&](size_t j) { return employees[j].position == target_position; },
+        [&](size_t j) { return employees[j].age; },
+        [&](size_t j) { return employees[j].salary; });
+    if (buckets.outside > 0) {
+        return query_multi_thread(employees, target_position, num_threads, work);
+    }
+    return buckets.finish();
+}
+
+QueryResult query_fused_multi_thread(const EmployeeTable& table, 
+                                     const string& target_position, 
+                                     int num_threads,
+                                     ThreadWork* work) {
+    if (table.size() == 0) {
+        return QueryResult{};
     }
+    int target_id = table.find_position(target_position);
+    const int* position_ids = table.position_ids.data();
+    const int* ages = table.ages.data();
+    const double* salaries = table.salaries.data();
     
-    for (auto& t : threads) {
-        t.join();
+    AgeBuckets buckets = fused_buckets_multi_thread(
+        table.size(), num_threads, work,
+        [=](size_t j) { return position_ids[j] == target_id; },
+        [=](size_t j) { return ages[j]; },
+        [=](size_t j) { return salaries[j]; });
+    if (buckets.outside > 0) {
+        return query_multi_thread(table, target_position, num_threads, work);
     }
+    return buckets.finish();
+}
+
+// Границы возраста для |age - average_age| <= age_range в целых числах
+static pair<int, int> age_window(double average_age, int age_range) {
+    return {static_cast<int>(ceil(average_age - age_range)),
+            static_cast<int>(floor(average_age + age_range))};
+}
+
+QueryResult query_simd_single_thread(const EmployeeTable& table, 
+                                     const string& target_position) {
+    QueryResult result;
+    int target_id = table.find_position(target_position);
     
-    double max_salary = 0.0;
-    for (int i = 0; i < num_threads; ++i) {
-        if (thread_phase2_max[i] > max_salary) {
-            max_salary = thread_phase2_max[i];
-        }
+    AgeSum age_sum = count_age_sum(table.position_ids.data(), table.ages.data(),
+                                   table.size(), target_id);
+    result.target_count = static_cast<int>(age_sum.count);
+    result.average_age = age_sum.count > 0
+        ? static_cast<double>(age_sum.sum) / age_sum.count : 0.0;
+    
+    auto [min_age, max_age] = age_window(result.average_age, 2);
+    result.max_salary = max_salary_in_age_range(table.position_ids.data(), table.ages.data(),
+                                                table.salaries.data(), table.size(),
+                                                target_id, min_age, max_age);
+    return result;
+}
+
+QueryResult query_simd_multi_thread(const EmployeeTable& table, 
+                                    const string& target_position, 
+                                    int num_threads,
+                                    ThreadWork* work) {
+    QueryResult result;
+    if (table.size() == 0) {
+        return result;
     }
     
-    cout << "\n=== Результаты обработки (многопоток) ===\n";
-    cout << "Использовано потоков: " << num_threads << "\n";
-    cout << "Всего сотрудников: " << employees.size() << "\n";
-    cout << "Сотрудников с должностью '" << target_position << "': " << total_count << "\n\n";
+    int target_id = table.find_position(target_position);
+    const int* position_ids = table.position_ids.data();
+    const int* ages = table.ages.data();
+    const double* salaries = table.salaries.data();
+    // Уровень читаем один раз: все потоки запроса работают одной версией ядра
+    SimdLevel level = simd_level();
     
-    if (total_count > 0) {
-        cout << "Средний возраст: " << fixed << setprecision(2) << average_age << " лет\n";
+    // Первая фаза: число совпадений и сумма возрастов по кускам
+    AgeSum total = reduce_scan<AgeSum>(table.size(), num_threads, work,
+        [&](AgeSum& acc, size_t start, size_t end) {
+            combine_age_sum(acc, count_age_sum(position_ids + start, ages + start, end - start,
+                                               target_id, level));
+        }, combine_age_sum);
+    result.target_count = static_cast<int>(total.count);
+    result.average_age = total.count > 0 ? static_cast<double>(total.sum) / total.count : 0.0;
+    
+    // Вторая фаза: максимум зарплаты в окне возраста
+    auto [min_age, max_age] = age_window(result.average_age, 2);
+    result.max_salary = reduce_scan<double>(table.size(), num_threads, work,
+        [&](double& acc, size_t start, size_t end) {
+            acc = max(acc, max_salary_in_age_range(position_ids + start, ages + start,
+                                                   salaries + start, end - start,
+                                                   target_id, min_age, max_age, level));
+        }, combine_max, 0.0);
+    return result;
+}
+
+// Запрос выбранным алгоритмом. Для строк векторных ядер нет - SIMD идет обычными проходами
+static QueryResult query_by_kind(const vector<Employee>& employees, const string& target_position,
+                                 int num_threads, QueryKind kind, ThreadWork* work) {
+    if (num_threads == 1) {
+        return kind == QueryKind::FUSED ? query_fused_single_thread(employees, target_position)
+                                        : query_single_thread(employees, target_position);
+    }
+    return kind == QueryKind::FUSED
+        ? query_fused_multi_thread(employees, target_position, num_threads, work)
+        : query_multi_thread(employees, target_position, num_threads, work);
+}
+
+static QueryResult query_by_kind(const EmployeeTable& table, const string& target_position,
+                                 int num_threads, QueryKind kind, ThreadWork* work) {
+    switch (kind) {
+        case QueryKind::FUSED:
+            return num_threads == 1
+                ? query_fused_single_thread(table, target_position)
+                : query_fused_multi_thread(table, target_position, num_threads, work);
+        case QueryKind::SIMD:
+            return num_threads == 1
+                ? query_simd_single_thread(table, target_position)
+                : query_simd_multi_thread(table, target_position, num_threads, work);
+        case QueryKind::PASSES:
+            break;
+    }
+    return num_threads == 1
+        ? query_single_thread(table, target_position)
+        : query_multi_thread(table, target_position, num_threads, work);
+}
+
+// Сколько раз однопоточный запрос проходит по данным (для строк SIMD - обычные проходы)
+static int single_thread_passes(QueryKind kind, bool columns) {
+    switch (kind) {
+        case QueryKind::FUSED: return 1;
+        case QueryKind::SIMD: return columns ? 2 : 3;
+        case QueryKind::PASSES: break;
+    }
+    return 3;
+}
+
+// Запрос выбранным алгоритмом (1 поток - без пула, работу потока считаем здесь)
+template <typename Data>
+static QueryResult run_query(const Data& data, const string& target_position,
+                             int num_threads, QueryKind kind,
+                             ThreadWork* work = nullptr) {
+    if (num_threads != 1) {
+        return query_by_kind(data, target_position, num_threads, kind, work);
+    }
+    auto started = chrono::steady_clock::now();
+    QueryResult result = query_by_kind(data, target_position, 1, kind, nullptr);
+    if (work != nullptr) {
+        work->busy_us.resize(1, 0.0);
+        work->rows.resize(1, 0);
+        work->busy_us[0] += chrono::duration<double, micro>(
+            chrono::steady_clock::now() - started).count();
+        work->rows[0] += static_cast<long long>(data.size()) *
+            single_thread_passes(kind, is_same_v<Data, EmployeeTable>);
+    }
+    return result;
+}
+
+// Вывод результата запроса
+static void print_query_result(const QueryResult& result, size_t total,
+                               const string& target_position) {
+    cout << "Всего сотрудников: " << total << "\n";
+    cout << "Сотрудников с должностью '" << target_position << "': " << result.target_count << "\n\n";
+    
+    if (result.target_count > 0) {
+        cout << "Средний возраст: " << fixed << setprecision(2) << result.average_age << " лет\n";
         cout << "Максимальная зарплата среди сотрудников\n";
         cout << "с возрастом +-2 года от среднего: " 
-                  << fixed << setprecision(2) << max_salary << " руб.\n";
+                  << fixed << setprecision(2) << result.max_salary << " руб.\n";
     } else {
         cout << "Нет сотрудников с должностью '" << target_position << "'\n";
     }
 }
 
+// Заголовок результата: потоки, представление данных и алгоритм
+static string result_title(const string& mode, bool columns, QueryKind kind) {
+    string title = mode;
+    if (columns) title += ", по столбцам";
+    if (kind == QueryKind::FUSED) title += ", один проход";
+    if (kind == QueryKind::SIMD && columns) title += ", векторный " + simd_level_name(simd_level());
+    return "\n=== Результаты обработки (" + title + ") ===\n";
+}
+
+// Однопоточная обработка
+void process_single_thread(const vector<Employee>& employees, 
+                          const string& target_position,
+                          QueryKind kind) {
+    QueryResult result = run_query(employees, target_position, 1, kind);
+    
+    cout << result_title("однопоток", false, kind);
+    print_query_result(result, employees.size(), target_position);
+}
+
+// Многопоток
+void process_multi_thread(const vector<Employee>& employees, 
+                         const string& target_position, 
+                         int num_threads,
+                         QueryKind kind) {
+    if (employees.empty()) {
+        cout << "Нет данных для обработки\n";
+        return;
+    }
+    
+    QueryResult result = run_query(employees, target_position, num_threads, kind);
+    
+    cout << result_title("многопоток", false, kind);
+    cout << "Использовано потоков: " << num_threads << "\n";
+    print_query_result(result, employees.size(), target_position);
+}
+
+// Те же запросы по столбцам
+void process_single_thread(const EmployeeTable& table, 
+                          const string& target_position,
+                          QueryKind kind) {
+    QueryResult result = run_query(table, target_position, 1, kind);
+    
+    cout << result_title("однопоток", true, kind);
+    print_query_result(result, table.size(), target_position);
+}
+
+void process_multi_thread(const EmployeeTable& table, 
+                         const string& target_position, 
+                         int num_threads,
+                         QueryKind kind) {
+    if (table.size() == 0) {
+        cout << "Нет данных для обработки\n";
+        return;
+    }
+    
+    QueryResult result = run_query(table, target_position, num_threads, kind);
+    
+    cout << result_title("многопоток", true, kind);
+    cout << "Использовано потоков: " << num_threads << "\n";
+    print_query_result(result, table.size(), target_position);
+}
+
+// Запрос по кругу: прогрев warmup_ms, затем окно duration_ms. Окно заканчивается
+// на границе запроса, поэтому делим на фактическое время, а не на duration_ms
+template <typename Data>
+static ScanThroughput measure_scan_throughput_impl(const Data& employees,
+                                                   const string& target_position,
+                                                   int num_threads, int duration_ms,
+                                                   int warmup_ms, QueryKind kind) {
+    ScanThroughput stats;
+    ThreadWork work;
+    double checksum = 0.0;
+    
+    auto warmup_end = chrono::steady_clock::now() + chrono::milliseconds(max(0, warmup_ms));
+    while (chrono::steady_clock::now() < warmup_end) {
+        checksum += run_query(employees, target_position, num_threads, kind).max_salary;
+    }
+    
+    auto window_start = chrono::steady_clock::now();
+    auto window_end = window_start + chrono::milliseconds(duration_ms);
+    auto now = window_start;
+    do {
+        checksum += run_query(employees, target_position, num_threads, kind,
+                              &work).max_salary;
+        stats.queries++;
+        now = chrono::steady_clock::now();
+    } while (now < window_end);
+    
+    stats.seconds = chrono::duration<double>(now - window_start).count();
+    stats.queries_per_second = stats.queries / stats.seconds;
+    stats.rows_per_second = stats.queries_per_second * employees.size();
+    
+    for (size_t i = 0; i < work.busy_us.size(); ++i) {
+        double busy_seconds = work.busy_us[i] / 1e6;
+        stats.thread_rows_per_second.push_back(
+            busy_seconds > 0 ? work.rows[i] / busy_seconds : 0.0);
+    }
+    stats.steals_per_query = static_cast<double>(work.steals) / stats.queries;
+    
+    // Не даем компилятору выбросить запросы
+    if (checksum < 0) {
+        cout << checksum;
+    }
+    return stats;
+}
+
+ScanThroughput measure_scan_throughput(const vector<Employee>& employees,
+                                       const string& target_position,
+                                       int num_threads, int duration_ms, int warmup_ms,
+                                       QueryKind kind) {
+    return measure_scan_throughput_impl(employees, target_position, num_threads,
+                                        duration_ms, warmup_ms, kind);
+}
+
+ScanThroughput measure_scan_throughput(const EmployeeTable& table,
+                                       const string& target_position,
+                                       int num_threads, int duration_ms, int warmup_ms,
+                                       QueryKind kind) {
+    return measure_scan_throughput_impl(table, target_position, num_threads,
+                                        duration_ms, warmup_ms, kind);
+}
+
 // Анализ производительности
 void analyze_performance(int min_size, int max_size, int step, 
                         const string& target_position) {
@@ -295,35 +828,171 @@ void analyze_performance(int min_size, int max_size, int step,
     cout << string(65, '-') << endl;
 }
 
+// Прогрев перед окном замера в режиме по времени
+constexpr int SCAN_WARMUP_MS = 200;
+
+// Вариант запроса в бенчмарке: векторный алгоритм - на каждом уровне SIMD, который есть у CPU
+struct QueryVariant {
+    QueryKind kind;
+    SimdLevel level;
+    string label;    // столбец "Алгоритм"
+    string suffix;   // в имя теста; у обычных проходов пустой, чтобы старые имена не менялись
+};
+
+static vector<QueryVariant> query_variants(bool columns) {
+    vector<QueryVariant> variants;
+    vector<QueryKind> kinds(begin(ALL_QUERY_KINDS), end(ALL_QUERY_KINDS));
+    if (!columns) {
+        kinds.assign(begin(ROW_QUERY_KINDS), end(ROW_QUERY_KINDS));
+    }
+    for (QueryKind kind : kinds) {
+        if (kind == QueryKind::SIMD) {
+            for (SimdLevel level : supported_simd_levels()) {
+                string label = query_kind_name(kind) + "_" + simd_level_name(level);
+                variants.push_back({kind, level, label, "_" + label});
+            }
+            continue;
+        }
+        string suffix = kind == QueryKind::PASSES ? "" : "_" + query_kind_name(kind);
+        variants.push_back({kind, simd_level(), query_kind_name(kind), suffix});
+    }
+    return variants;
+}
+
+// бенчмарк по времени: запросов и строк в секунду для каждой конфигурации
+static void run_employees_throughput(const vector<int>& test_sizes,
+                                     const vector<int>& thread_counts,
+                                     const string& target_position, int duration_ms) {
+    cout << "Режим по времени: прогрев " << SCAN_WARMUP_MS << " мс, окно "
+              << duration_ms << " мс на конфигурацию\n";
+    
+    vector<string> names;
+    vector<vector<double>> rows;
+    int max_threads = *max_element(thread_counts.begin(), thread_counts.end());
+    vector<string> columns = {"Запросов_в_сек", "Строк_в_сек", "Запросов", "Окно_сек",
+                              "Краж_на_запрос"};
+    for (int i = 0; i < max_threads; ++i) {
+        columns.push_back("Поток_" + to_string(i) + "_строк_в_сек");
+    }
+    
+    // Все алгоритмы и потоки над данными data (строки или столбцы), suffix - в имя теста
+    auto measure = [&](const auto& data, int size, const string& layout, const string& suffix) {
+        SimdLevel saved_level = simd_level();
+        for (const QueryVariant& variant : query_variants(is_same_v<decay_t<decltype(data)>, EmployeeTable>)) {
+            simd_level() = variant.level;
+            for (int threads : thread_counts) {
+                ScanThroughput stats = measure_scan_throughput(data, target_position, threads,
+                                                               duration_ms, SCAN_WARMUP_MS,
+                                                               variant.kind);
+                auto [min_it, max_it] = minmax_element(stats.thread_rows_per_second.begin(),
+                                                       stats.thread_rows_per_second.end());
+                
+                cout << setw(12) << left << layout
+                          << setw(22) << variant.label
+                          << setw(10) << threads
+                          << setw(20) << fixed << setprecision(1) << stats.queries_per_second
+                          << setw(20) << setprecision(0) << stats.rows_per_second
+                          << setw(20) << *min_it
+                          << setw(20) << *max_it
+                          << setw(12) << setprecision(1) << stats.steals_per_query << endl;
+                
+                names.push_back(to_string(size) + "_сотр_" + to_string(threads) + "_потоков" +
+                                suffix + variant.suffix);
+                vector<double> row = {stats.queries_per_second, stats.rows_per_second,
+                                      static_cast<double>(stats.queries), stats.seconds,
+                                      stats.steals_per_query};
+                row.insert(row.end(), stats.thread_rows_per_second.begin(),
+                           stats.thread_rows_per_second.end());
+                // Нули для потоков, которых в конфигурации нет
+                row.resize(columns.size(), 0.0);
+                rows.push_back(row);
+            }
+        }
+        simd_level() = saved_level;
+    };
+    
+    for (int size : test_sizes) {
+        cout << "\nГенерация " << size << " сотрудников...\n";
+        
+        cout << setw(12) << left << "Данные"
+                  << setw(22) << "Алгоритм"
+                  << setw(10) << "Потоки"
+                  << setw(20) << "Запросов/с"
+                  << setw(20) << "Строк/с"
+                  << setw(20) << "Мин/поток"
+                  << setw(20) << "Макс/поток"
+                  << setw(12) << "Краж" << "\n";
+        cout << string(136, '-') << endl;
+        
+        // Строки и столбцы по очереди, чтобы в памяти не было обеих копий 10M сотрудников
+        {
+            auto employees = generate_employees(size, target_position);
+            measure(employees, size, "строки", "");
+        }
+        {
+            auto table = generate_employee_table(size, target_position);
+            measure(table, size, "столбцы", "_столбцы");
+        }
+        cout << string(136, '-') << endl;
+    }
+    
+    Benchmark::save_matrix_to_csv(names, columns, rows, "employees_throughput.csv");
+}
+
 // бенчмарк
-void run_employees_benchmark() {
+void run_employees_benchmark(int duration_ms) {
     cout << "\n=== Бенчмарк анализа сотрудников ===\n";
     
     string target_position = "Инженер";
     vector<int> test_sizes = {1000, 5000, 10000, 50000, 100000, 1000000, 10000000};
     vector<int> thread_counts = {1, 2, 4, 8};
     
+    if (duration_ms > 0) {
+        run_employees_throughput(test_sizes, thread_counts, target_position, duration_ms);
+        return;
+    }
+    
     vector<pair<string, double>> benchmark_results;
+    vector<PerfSample> benchmark_perf;
+    
+    // Все алгоритмы и конфигурации потоков над данными data (строки или столбцы)
+    auto run_configs = [&](const auto& data, int size, const string& suffix) {
+        SimdLevel saved_level = simd_level();
+        for (const QueryVariant& variant : query_variants(is_same_v<decay_t<decltype(data)>, EmployeeTable>)) {
+            simd_level() = variant.level;
+            for (int threads : thread_counts) {
+                string test_name = to_string(size) + "_сотр_" + to_string(threads) + "_потоков" +
+                                   suffix + variant.suffix;
+                
+                Benchmark b(test_name, false);
+                if (threads == 1) {
+                    process_single_thread(data, target_position, variant.kind);
+                } else {
+                    process_multi_thread(data, target_position, threads, variant.kind);
+                }
+                
+                benchmark_results.emplace_back(test_name, b.elapsed_microseconds());
+                benchmark_perf.push_back(b.perf_counters());
+            }
+        }
+        simd_level() = saved_level;
+    };
     
     for (int size : test_sizes) {
         cout << "\nГенерация " << size << " сотрудников...\n";
-        auto employees = generate_employees(size, target_position);
-        
-        for (int threads : thread_counts) {
-            string test_name = to_string(size) + "_сотр_" + to_string(threads) + "_потоков";
-            
-            Benchmark b(test_name, false);
-            if (threads == 1) {
-                process_single_thread(employees, target_position);
-            } else {
-                process_multi_thread(employees, target_position, threads);
-            }
-            
-            benchmark_results.emplace_back(test_name, b.elapsed_microseconds());
+        // Строки и столбцы по очереди, чтобы в памяти не было обеих копий
+        {
+            auto employees = generate_employees(size, target_position);
+            run_configs(employees, size, "");
+        }
+        {
+            auto table = generate_employee_table(size, target_position);
+            run_configs(table, size, "_столбцы");
         }
     }
     
-    Benchmark::save_to_csv(benchmark_results, "employees_benchmark.csv");
+    Benchmark::print_perf(benchmark_results, benchmark_perf);
+    Benchmark::save_to_csv(benchmark_results, {}, benchmark_perf, "employees_benchmark.csv");
     cout << "\nБенчмарк завершен. Результаты сохранены в employees_benchmark.csv\n";
 }
 
@@ -338,6 +1007,7 @@ void run_employees() {
     cout << "1. Стандартный анализ\n";
     cout << "2. Анализ производительности\n";
     cout << "3. Полный бенчмарк\n";
+    cout << "4. Бенчмарк по времени (запросов и строк в секунду)\n";
     cout << "Ваш выбор: ";
     cin >> choice;
     
@@ -386,6 +1056,67 @@ void run_employees() {
             Benchmark::print_comparison("Однопоток", single_time, 
                                        "Многопоток (" + to_string(num_threads) + " потоков)", 
                                        multi_time);
+            
+            // Те же запросы по столбцам с номерами должностей
+            EmployeeTable table = EmployeeTable::from_rows(employees);
+            double table_single_time, table_multi_time;
+            
+            {
+                Benchmark b("Однопоточная обработка (по столбцам)");
+                process_single_thread(table, target_position);
+                table_single_time = b.elapsed_microseconds();
+            }
+            
+            {
+                Benchmark b("Многопоточная обработка (по столбцам)");
+                process_multi_thread(table, target_position, num_threads);
+                table_multi_time = b.elapsed_microseconds();
+            }
+            
+            Benchmark::print_comparison("Однопоток (строки)", single_time, 
+                                       "Однопоток (столбцы)", table_single_time);
+            Benchmark::print_comparison("Многопоток (строки)", multi_time, 
+                                       "Многопоток (столбцы)", table_multi_time);
+            
+            // Один проход с корзинами по возрастам вместо нескольких проходов
+            double fused_single_time, fused_multi_time;
+            
+            {
+                Benchmark b("Однопоточная обработка (столбцы, один проход)");
+                process_single_thread(table, target_position, QueryKind::FUSED);
+                fused_single_time = b.elapsed_microseconds();
+            }
+            
+            {
+                Benchmark b("Многопоточная обработка (столбцы, один проход)");
+                process_multi_thread(table, target_position, num_threads, QueryKind::FUSED);
+                fused_multi_time = b.elapsed_microseconds();
+            }
+            
+            Benchmark::print_comparison("Однопоток (проходы)", table_single_time, 
+                                       "Однопоток (один проход)", fused_single_time);
+            Benchmark::print_comparison("Многопоток (проходы)", table_multi_time, 
+                                       "Многопоток (один проход)", fused_multi_time);
+            
+            // Проходы векторными ядрами (уровень SIMD выбран по CPU или BENCH_SIMD)
+            double simd_single_time, simd_multi_time;
+            
+            {
+                Benchmark b("Однопоточная обработка (столбцы, " + simd_level_name(simd_level()) + ")");
+                process_single_thread(table, target_position, QueryKind::SIMD);
+                simd_single_time = b.elapsed_microseconds();
+            }
+            
+            {
+                Benchmark b("Многопоточная обработка (столбцы, " + simd_level_name(simd_level()) + ")");
+                process_multi_thread(table, target_position, num_threads, QueryKind::SIMD);
+                simd_multi_time = b.elapsed_microseconds();
+            }
+            
+            Benchmark::print_comparison("Однопоток (проходы)", table_single_time, 
+                                       "Однопоток (векторный)", simd_single_time);
+            Benchmark::print_comparison("Многопоток (проходы)", table_multi_time, 
+                                       "Многопоток (векторный)", simd_multi_time);
             break;
         }
         case 2:
@@ -394,6 +1125,15 @@ void run_employees() {
         case 3:
             run_employees_benchmark();
             break;
+        case 4: {
+            int seconds;
+            cout << "\nВведите длительность окна в секундах на конфигурацию (1-60): ";
+            cin >> seconds;
+            if (seconds < 1) seconds = 1;
+            if (seconds > 60) seconds = 60;
+            run_employees_benchmark(seconds * 1000);
+            break;
+        }
         default:
             cout << "Неверный выбор! Запускаю стандартный анализ...\n";
             auto employees = generate_employees(5000, target_position);
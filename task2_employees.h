@@ -9,6 +9,24 @@ using namespace std;
 
 namespace task2 {
 
+// Диапазон возрастов сотрудников (generate_employees дает возраст только в нем)
+constexpr int MIN_EMPLOYEE_AGE = 20;
+constexpr int MAX_EMPLOYEE_AGE = 65;
+
+// Алгоритм запроса
+enum class QueryKind {
+    PASSES,   // отдельные проходы: средний возраст, затем максимум зарплаты около него
+    FUSED,    // один проход: по каждому возрасту счетчик и максимум зарплаты, затем слияние
+    SIMD      // проходы векторными ядрами simd_kernels.h (только по столбцам)
+};
+
+constexpr QueryKind ALL_QUERY_KINDS[] = {QueryKind::PASSES, QueryKind::FUSED, QueryKind::SIMD};
+
+// Алгоритмы для строк (vector<Employee>): векторных ядер для них нет
+constexpr QueryKind ROW_QUERY_KINDS[] = {QueryKind::PASSES, QueryKind::FUSED};
+
+string query_kind_name(QueryKind kind);
+
 struct Employee {
     string name;           // ФИО
     string position;       // Должность
@@ -19,24 +37,138 @@ struct Employee {
         : name(n), position(p), age(a), salary(s) {}
 };
 
+// Те же сотрудники по столбцам. Должности закодированы номерами в словаре, поэтому
+// запрос сравнивает целые числа и читает только нужные ему столбцы
+class EmployeeTable {
+public:
+    vector<string> names;          // ФИО
+    vector<int> position_ids;      // Номер должности в positions
+    vector<int> ages;              // Возраст
+    vector<double> salaries;       // Заработная плата
+    vector<string> positions;      // Словарь должностей: номер -> название
+    
+    size_t size() const { return position_ids.size(); }
+    
+    // Номер должности в словаре (-1, если такой должности нет)
+    int find_position(const string& position) const;
+    // Номер должности, новая добавляется в словарь
+    int encode_position(const string& position);
+    
+    void push_back(const Employee& employee);
+    Employee row(size_t i) const;
+    
+    static EmployeeTable from_rows(const vector<Employee>& employees);
+};
+
+// Результат запроса: средний возраст должности и максимальная зарплата около него
+struct QueryResult {
+    int target_count = 0;
+    double average_age = 0.0;
+    double max_salary = 0.0;
+};
+
+// Работа потоков запроса: время и просмотренные строки (по всем проходам) каждого потока
+struct ThreadWork {
+    vector<double> busy_us;
+    vector<long long> rows;
+    long long steals = 0;                     // диапазонов, украденных у других потоков
+};
+
+// Пропускная способность запроса за окно времени
+struct ScanThroughput {
+    long long queries = 0;
+    double seconds = 0.0;
+    double queries_per_second = 0.0;
+    double rows_per_second = 0.0;             // сотрудников в секунду (размер * запросов / время)
+    vector<double> thread_rows_per_second;    // по потокам: просмотренные строки / время работы
+    double steals_per_query = 0.0;
+};
+
 // Основные функции
 void run_employees();
-void run_employees_benchmark();
+// duration_ms > 0 - режим по времени: каждая конфигурация крутится duration_ms после прогрева
+void run_employees_benchmark(int duration_ms = 0);
 
 // Вспомогательные функции
 vector<Employee> generate_employees(int count, const string& target_position);
+// Те же данные (при том же seed), сразу по столбцам
+EmployeeTable generate_employee_table(int count, const string& target_position);
 double calculate_average_age(const vector<Employee>& employees, const string& target_position);
+double calculate_average_age(const EmployeeTable& table, const string& target_position);
 double find_max_salary_near_average(const vector<Employee>& employees, 
                                    const string& target_position, 
                                    double average_age, 
                                    int age_range = 2);
+double find_max_salary_near_average(const EmployeeTable& table, 
+                                   const string& target_position, 
+                                   double average_age, 
+                                   int age_range = 2);
+
+// Запрос без вывода. work (если задан) накапливает работу каждого потока.
+// Многопоточные запросы идут по кускам через WorkStealingScheduler
+QueryResult query_single_thread(const vector<Employee>& employees, 
+                                const string& target_position);
+QueryResult query_multi_thread(const vector<Employee>& employees, 
+                               const string& target_position, 
+                               int num_threads,
+                               ThreadWork* work = nullptr);
+QueryResult query_single_thread(const EmployeeTable& table, 
+                                const string& target_position);
+QueryResult query_multi_thread(const EmployeeTable& table, 
+                               const string& target_position, 
+                               int num_threads,
+                               ThreadWork* work = nullptr);
+
+// Один проход по данным: по возрастам MIN_EMPLOYEE_AGE..MAX_EMPLOYEE_AGE считаем число
+// сотрудников должности и их максимальную зарплату, ответ собираем из этих корзин.
+// Если встретился возраст вне диапазона, запрос повторяется обычными проходами
+QueryResult query_fused_single_thread(const vector<Employee>& employees, 
+                                      const string& target_position);
+QueryResult query_fused_single_thread(const EmployeeTable& table, 
+                                      const string& target_position);
+QueryResult query_fused_multi_thread(const vector<Employee>& employees, 
+                                     const string& target_position, 
+                                     int num_threads,
+                                     ThreadWork* work = nullptr);
+QueryResult query_fused_multi_thread(const EmployeeTable& table, 
+                                     const string& target_position, 
+                                     int num_threads,
+                                     ThreadWork* work = nullptr);
 
-// Функции обработки
+// Те же проходы, что и query_*_thread, но фильтр и свертка идут векторными ядрами
+// уровня simd_level() (AVX-512, AVX2 или скалярный цикл - по возможностям CPU)
+QueryResult query_simd_single_thread(const EmployeeTable& table, 
+                                     const string& target_position);
+QueryResult query_simd_multi_thread(const EmployeeTable& table, 
+                                    const string& target_position, 
+                                    int num_threads,
+                                    ThreadWork* work = nullptr);
+
+// Повторяет запрос warmup_ms, затем считает запросы за окно duration_ms (1 поток - однопоточный)
+ScanThroughput measure_scan_throughput(const vector<Employee>& employees,
+                                       const string& target_position,
+                                       int num_threads, int duration_ms, int warmup_ms,
+                                       QueryKind kind = QueryKind::PASSES);
+ScanThroughput measure_scan_throughput(const EmployeeTable& table,
+                                       const string& target_position,
+                                       int num_threads, int duration_ms, int warmup_ms,
+                                       QueryKind kind = QueryKind::PASSES);
+
+// Функции обработки (запрос и вывод результата)
 void process_single_thread(const vector<Employee>& employees, 
-                          const string& target_position);
+                          const string& target_position,
+                          QueryKind kind = QueryKind::PASSES);
 void process_multi_thread(const vector<Employee>& employees, 
                          const string& target_position, 
-                         int num_threads);
+                         int num_threads,
+                         QueryKind kind = QueryKind::PASSES);
+void process_single_thread(const EmployeeTable& table, 
+                          const string& target_position,
+                          QueryKind kind = QueryKind::PASSES);
+void process_multi_thread(const EmployeeTable& table, 
+                         const string& target_position, 
+                         int num_threads,
+                         QueryKind kind = QueryKind::PASSES);
 
 // Анализ производительности
 void analyze_performance(int min_size, int max_size, int step, 
@@ -1,10 +1,11 @@
 #include "task3_philosophers.h"
 #include "benchmark_utils.h"
+#include "fast_random.h"
+#include "worker_pool.h"
 #include <iostream>
 #include <thread>
 #include <vector>
 #include <mutex>
-#include <random>
 #include <chrono>
 #include <algorithm>
 #include <iomanip>
@@ -73,10 +74,7 @@ void DiningPhilosophers::philosopher_mutex(int id, int iterations, bool verbose)
     auto& forks = DiningPhilosophersImpl::forks;
     auto& cout_mutex = DiningPhilosophersImpl::cout_mutex;
     
-    random_device rd;
-    mt19937 gen(rd());
-    uniform_int_distribution<> think_dist(50, 200);
-    uniform_int_distribution<> eat_dist(100, 300);
+    Xoshiro256 rng = Xoshiro256::for_thread(benchmark_seed(), id);
     
     int left_fork = id;
     int right_fork = (id + 1) % num_philosophers_;
@@ -99,7 +97,7 @@ void DiningPhilosophers::philosopher_mutex(int id, int iterations, bool verbose)
         }
         
         // Еда
-        this_thread::sleep_for(chrono::milliseconds(eat_dist(gen)));
+        this_thread::sleep_for(chrono::milliseconds(rng.uniform(100, 300)));
         
         // Освобождение вилок
         forks[left_fork].unlock();
@@ -111,7 +109,7 @@ void DiningPhilosophers::philosopher_mutex(int id, int iterations, bool verbose)
         }
         
         // Размышление
-        this_thread::sleep_for(chrono::milliseconds(think_dist(gen)));
+        this_thread::sleep_for(chrono::milliseconds(rng.uniform(50, 200)));
     }
 }
 
@@ -119,10 +117,7 @@ void DiningPhilosophers::philosopher_semaphore(int id, int iterations, bool verb
     auto& sem_forks = DiningPhilosophersImpl::sem_forks;
     auto& cout_mutex = DiningPhilosophersImpl::cout_mutex;
     
-    random_device rd;
-    mt19937 gen(rd());
-    uniform_int_distribution<> think_dist(50, 200);
-    uniform_int_distribution<> eat_dist(100, 300);
+    Xoshiro256 rng = Xoshiro256::for_thread(benchmark_seed(), id);
     
     int left_fork = id;
     int right_fork = (id + 1) % num_philosophers_;
@@ -143,7 +138,7 @@ void DiningPhilosophers::philosopher_semaphore(int id, int iterations, bool verb
         }
         
         // Еда
-        this_thread::sleep_for(chrono::milliseconds(eat_dist(gen)));
+        this_thread::sleep_for(chrono::milliseconds(rng.uniform(100, 300)));
         
         // Освобождение вилок
         sem_forks[left_fork].release();
@@ -155,7 +150,7 @@ void DiningPhilosophers::philosopher_semaphore(int id, int iterations, bool verb
         }
         
         // Размышление
-        this_thread::sleep_for(chrono::milliseconds(think_dist(gen)));
+        this_thread::sleep_for(chrono::milliseconds(rng.uniform(50, 200)));
     }
 }
 
@@ -163,11 +158,7 @@ void DiningPhilosophers::philosopher_try_lock(int id, int iterations, bool verbo
     auto& forks = DiningPhilosophersImpl::forks;
     auto& cout_mutex = DiningPhilosophersImpl::cout_mutex;
     
-    random_device rd;
-    mt19937 gen(rd());
-    uniform_int_distribution<> think_dist(50, 200);
-    uniform_int_distribution<> eat_dist(100, 300);
-    uniform_int_distribution<> retry_dist(10, 50);
+    Xoshiro256 rng = Xoshiro256::for_thread(benchmark_seed(), id);
     
     int left_fork = id;
     int right_fork = (id + 1) % num_philosophers_;
@@ -187,11 +178,11 @@ void DiningPhilosophers::philosopher_try_lock(int id, int iterations, bool verbo
                 } else {
                     // Не удалось захватить правую - отпускаем левую
                     forks[left_fork].unlock();
-                    this_thread::sleep_for(chrono::milliseconds(retry_dist(gen)));
+                    this_thread::sleep_for(chrono::milliseconds(rng.uniform(10, 50)));
                 }
             } else {
                 // Не удалось захватить левую - ждем
-                this_thread::sleep_for(chrono::milliseconds(retry_dist(gen)));
+                this_thread::sleep_for(chrono::milliseconds(rng.uniform(10, 50)));
             }
         }
         
@@ -207,7 +198,7 @@ void DiningPhilosophers::philosopher_try_lock(int id, int iterations, bool verbo
         }
         
         // Еда
-        this_thread::sleep_for(chrono::milliseconds(eat_dist(gen)));
+        this_thread::sleep_for(chrono::milliseconds(rng.uniform(100, 300)));
         
         // Освобождение вилок
         forks[left_fork].unlock();
@@ -219,7 +210,7 @@ void DiningPhilosophers::philosopher_try_lock(int id, int iterations, bool verbo
         }
         
         // Размышление
-        this_thread::sleep_for(chrono::milliseconds(think_dist(gen)));
+        this_thread::sleep_for(chrono::milliseconds(rng.uniform(50, 200)));
     }
 }
 
@@ -229,10 +220,7 @@ void DiningPhilosophers::philosopher_arbitrator(int id, int iterations, bool ver
     auto& arbitrator_cv = DiningPhilosophersImpl::arbitrator_cv;
     auto& cout_mutex = DiningPhilosophersImpl::cout_mutex;
     
-    random_device rd;
-    mt19937 gen(rd());
-    uniform_int_distribution<> think_dist(50, 200);
-    uniform_int_distribution<> eat_dist(100, 300);
+    Xoshiro256 rng = Xoshiro256::for_thread(benchmark_seed(), id);
     
     int left_fork = id;
     int right_fork = (id + 1) % num_philosophers_;
@@ -257,7 +245,7 @@ void DiningPhilosophers::philosopher_arbitrator(int id, int iterations, bool ver
         }
         
         // Еда
-        this_thread::sleep_for(chrono::milliseconds(eat_dist(gen)));
+        this_thread::sleep_for(chrono::milliseconds(rng.uniform(100, 300)));
         
         // Возврат вилок арбитру
         {
@@ -273,7 +261,7 @@ void DiningPhilosophers::philosopher_arbitrator(int id, int iterations, bool ver
         }
         
         // Размышление
-        this_thread::sleep_for(chrono::milliseconds(think_dist(gen)));
+        this_thread::sleep_for(chrono::milliseconds(rng.uniform(50, 200)));
     }
 }
 
@@ -281,10 +269,7 @@ void DiningPhilosophers::philosopher_resource_hierarchy(int id, int iterations,
     auto& forks = DiningPhilosophersImpl::forks;
     auto& cout_mutex = DiningPhilosophersImpl::cout_mutex;
     
-    random_device rd;
-    mt19937 gen(rd());
-    uniform_int_distribution<> think_dist(50, 200);
-    uniform_int_distribution<> eat_dist(100, 300);
+    Xoshiro256 rng = Xoshiro256::for_thread(benchmark_seed(), id);
     
     int left_fork = id;
     int right_fork = (id + 1) % num_philosophers_;
@@ -304,7 +289,7 @@ void DiningPhilosophers::philosopher_resource_hierarchy(int id, int iterations,
         }
         
         // Еда
-        this_thread::sleep_for(chrono::milliseconds(eat_dist(gen)));
+        this_thread::sleep_for(chrono::milliseconds(rng.uniform(100, 300)));
         
         // Освобождение вилок (в обратном порядке)
         forks[second_fork].unlock();
@@ -316,13 +301,11 @@ void DiningPhilosophers::philosopher_resource_hierarchy(int id, int iterations,
         }
         
         // Размышление
-        this_thread::sleep_for(chrono::milliseconds(think_dist(gen)));
+        this_thread::sleep_for(chrono::milliseconds(rng.uniform(50, 200)));
     }
 }
 
 void DiningPhilosophers::run_simulation(int iterations, bool verbose) {
-    vector<thread> philosophers;
-    
     string strategy_name;
     switch (strategy_) {
         case Strategy::MUTEX: strategy_name = "Мьютексы"; break;
@@ -342,36 +325,26 @@ void DiningPhilosophers::run_simulation(int iterations, bool verbose) {
         cout << "(Вывод ограничен первыми 10 итерациями)\n";
     }
     
-    // Запуск философов
-    for (int i = 0; i < num_philosophers_; ++i) {
+    // Запуск философов на общем пуле потоков: все начинают вместе у стартовых ворот
+    WorkerPool::instance().run(num_philosophers_, [&](int i) {
         switch (strategy_) {
             case Strategy::MUTEX:
-                philosophers.emplace_back(&DiningPhilosophers::philosopher_mutex, 
-                                         this, i, iterations, verbose);
+                philosopher_mutex(i, iterations, verbose);
                 break;
             case Strategy::SEMAPHORE:
-                philosophers.emplace_back(&DiningPhilosophers::philosopher_semaphore, 
-                                         this, i, iterations, verbose);
+                philosopher_semaphore(i, iterations, verbose);
                 break;
             case Strategy::TRY_LOCK:
-                philosophers.emplace_back(&DiningPhilosophers::philosopher_try_lock, 
-                                         this, i, iterations, verbose);
+                philosopher_try_lock(i, iterations, verbose);
                 break;
             case Strategy::ARBITRATOR:
-                philosophers.emplace_back(&DiningPhilosophers::philosopher_arbitrator, 
-                                         this, i, iterations, verbose);
+                philosopher_arbitrator(i, iterations, verbose);
                 break;
             case Strategy::RESOURCE_HIERARCHY:
-                philosophers.emplace_back(&DiningPhilosophers::philosopher_resource_hierarchy, 
-                                         this, i, iterations, verbose);
+                philosopher_resource_hierarchy(i, iterations, verbose);
                 break;
         }
-    }
-    
-    // Ожидание завершения
-    for (auto& p : philosophers) {
-        p.join();
-    }
+    });
     
     cout << "\nСимуляция завершена успешно!\n";
 }
@@ -412,10 +385,10 @@ void DiningPhilosophers::run_benchmark(int max_philosophers, int iterations) {
             DiningPhilosophers dp(count, strategies[s]);
             
             try {
-                Benchmark b(test_name, false);
                 dp.run_simulation(iterations, false);
                 
-                double time = b.elapsed_microseconds();
+                // Только время трапезы, без запуска потоков
+                double time = WorkerPool::instance().last_run_microseconds();
                 benchmark_results.emplace_back(test_name, time);
                 
                 cout << time << " мкс\n";
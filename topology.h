@@ -0,0 +1,269 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <thread>
+#include <tuple>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace std;
+
+// Политики размещения потоков по логическим CPU
+enum class PlacementPolicy {
+    NONE,            // как решит планировщик
+    COMPACT,         // заполняем один сокет, сначала разные ядра, потом их SMT-соседей
+    SCATTER,         // по кругу между сокетами и ядрами
+    PHYSICAL_CORES,  // по одному потоку на физическое ядро
+    SMT_PAIRS        // парами на SMT-соседях одного ядра
+};
+
+constexpr PlacementPolicy ALL_PLACEMENT_POLICIES[] = {
+    PlacementPolicy::NONE, PlacementPolicy::COMPACT, PlacementPolicy::SCATTER,
+    PlacementPolicy::PHYSICAL_CORES, PlacementPolicy::SMT_PAIRS
+};
+
+inline string placement_name(PlacementPolicy policy) {
+    switch (policy) {
+        case PlacementPolicy::NONE: return "none";
+        case PlacementPolicy::COMPACT: return "compact";
+        case PlacementPolicy::SCATTER: return "scatter";
+        case PlacementPolicy::PHYSICAL_CORES: return "physcores";
+        case PlacementPolicy::SMT_PAIRS: return "smtpairs";
+    }
+    return "none";
+}
+
+// Топология процессора из /sys/devices/system/cpu
+class CpuTopology {
+public:
+    struct Cpu {
+        int id;          // номер логического CPU
+        int core;        // core_id внутри сокета
+        int package;     // physical_package_id
+        int smt_index;   // номер среди SMT-соседей ядра (0 - первый)
+        int node;        // NUMA-узел (плотный номер 0..num_nodes-1)
+    };
+
+private:
+    vector<Cpu> cpus;
+    vector<int> cpu_node;   // номер логического CPU -> NUMA-узел
+    int nodes = 1;
+
+    static int read_int(const string& path, int fallback) {
+        ifstream file(path);
+        int value;
+        if (file >> value) {
+            return value;
+        }
+        return fallback;
+    }
+
+    // Разбор списка вида "0-3,8,10-11"
+    static vector<int> parse_cpu_list(const string& list) {
+        vector<int> result;
+        stringstream ss(list);
+        string range;
+        while (getline(ss, range, ',')) {
+            if (range.empty()) continue;
+            size_t dash = range.find('-');
+            int first = stoi(range.substr(0, dash));
+            int last = dash == string::npos ? first : stoi(range.substr(dash + 1));
+            for (int c = first; c <= last; ++c) {
+                result.push_back(c);
+            }
+        }
+        return result;
+    }
+
+    CpuTopology() {
+        const string base = "/sys/devices/system/cpu/";
+        vector<int> online;
+
+        ifstream online_file(base + "online");
+        string list;
+        if (getline(online_file, list)) {
+            try {
+                online = parse_cpu_list(list);
+            } catch (const exception&) {
+                online.clear();
+            }
+        }
+        if (online.empty()) {
+            int n = max(1u, thread::hardware_concurrency());
+            for (int c = 0; c < n; ++c) {
+                online.push_back(c);
+            }
+        }
+
+        for (int c : online) {
+            string topo = base + "cpu" + to_string(c) + "/topology/";
+            cpus.push_back({c, read_int(topo + "core_id", c),
+                            read_int(topo + "physical_package_id", 0), 0, 0});
+        }
+
+        // NUMA-узлы из /sys/devices/system/node: без них (или без NUMA) все CPU в узле 0
+        cpu_node.assign(cpus.back().id + 1, 0);
+        const string node_base = "/sys/devices/system/node/";
+        ifstream nodes_file(node_base + "online");
+        string node_list;
+        if (getline(nodes_file, node_list)) {
+            try {
+                vector<int> node_ids = parse_cpu_list(node_list);
+                for (size_t n = 0; n < node_ids.size(); ++n) {
+                    ifstream cpulist_file(node_base + "node" + to_string(node_ids[n]) + "/cpulist");
+                    string cpulist;
+                    if (!getline(cpulist_file, cpulist)) continue;
+                    for (int c : parse_cpu_list(cpulist)) {
+                        if (c < static_cast<int>(cpu_node.size())) {
+                            cpu_node[c] = static_cast<int>(n);
+                        }
+                    }
+                }
+                nodes = max(1, static_cast<int>(node_ids.size()));
+            } catch (const exception&) {
+                cpu_node.assign(cpu_node.size(), 0);
+                nodes = 1;
+            }
+        }
+        for (auto& cpu : cpus) {
+            cpu.node = cpu_node[cpu.id];
+        }
+
+        // Номер SMT-соседа: порядок логического CPU среди CPU того же ядра
+        for (auto& cpu : cpus) {
+            for (const auto& other : cpus) {
+                if (other.package == cpu.package && other.core == cpu.core && other.id < cpu.id) {
+                    cpu.smt_index++;
+                }
+            }
+        }
+    }
+
+public:
+    static const CpuTopology& instance() {
+        static CpuTopology topology;
+        return topology;
+    }
+
+    const vector<Cpu>& all() const { return cpus; }
+
+    int num_cpus() const { return static_cast<int>(cpus.size()); }
+
+    int num_cores() const {
+        return static_cast<int>(count_if(cpus.begin(), cpus.end(),
+                                         [](const Cpu& c) { return c.smt_index == 0; }));
+    }
+
+    int num_packages() const {
+        vector<int> packages;
+        for (const auto& c : cpus) {
+            if (find(packages.begin(), packages.end(), c.package) == packages.end()) {
+                packages.push_back(c.package);
+            }
+        }
+        return static_cast<int>(packages.size());
+    }
+
+    // Порядок CPU, в котором политика раздает их потокам (поток i -> order[i % size])
+    vector<int> placement_order(PlacementPolicy policy) const {
+        vector<Cpu> sorted = cpus;
+
+        switch (policy) {
+            case PlacementPolicy::NONE:
+                return {};
+            case PlacementPolicy::COMPACT:
+                sort(sorted.begin(), sorted.end(), [](const Cpu& a, const Cpu& b) {
+                    return tie(a.package, a.smt_index, a.core, a.id) <
+                           tie(b.package, b.smt_index, b.core, b.id);
+                });
+                break;
+            case PlacementPolicy::SMT_PAIRS:
+                sort(sorted.begin(), sorted.end(), [](const Cpu& a, const Cpu& b) {
+                    return tie(a.package, a.core, a.smt_index, a.id) <
+                           tie(b.package, b.core, b.smt_index, b.id);
+                });
+                break;
+            case PlacementPolicy::PHYSICAL_CORES:
+                sorted.erase(remove_if(sorted.begin(), sorted.end(),
+                                       [](const Cpu& c) { return c.smt_index != 0; }),
+                             sorted.end());
+                [[fallthrough]];
+            case PlacementPolicy::SCATTER: {
+                // Ранг ядра внутри своего сокета, чтобы чередовать сокеты
+                vector<int> core_rank(cpus.back().id + 1, 0);
+                for (const auto& c : cpus) {
+                    for (const auto& other : cpus) {
+                        if (other.package == c.package && other.smt_index == 0 &&
+                            other.core < c.core) {
+                            core_rank[c.id]++;
+                        }
+                    }
+                }
+                sort(sorted.begin(), sorted.end(), [&](const Cpu& a, const Cpu& b) {
+                    return tie(a.smt_index, core_rank[a.id], a.package, a.id) <
+                           tie(b.smt_index, core_rank[b.id], b.package, b.id);
+                });
+                break;
+            }
+        }
+
+        vector<int> order;
+        for (const auto& c : sorted) {
+            order.push_back(c.id);
+        }
+        return order;
+    }
+
+    int num_nodes() const { return nodes; }
+
+    // NUMA-узел логического CPU
+    int node_of(int cpu) const {
+        if (cpu < 0 || cpu >= static_cast<int>(cpu_node.size())) return 0;
+        return cpu_node[cpu];
+    }
+
+    // NUMA-узел CPU, на котором сейчас выполняется поток
+    int current_node() const {
+#ifdef __linux__
+        return node_of(sched_getcpu());
+#else
+        return 0;
+#endif
+    }
+
+    string summary() const {
+        ostringstream out;
+        out << num_cpus() << " логических CPU, " << num_cores() << " физических ядер, "
+            << num_packages() << " сокет(ов), " << num_nodes() << " NUMA-узл(ов)";
+        return out.str();
+    }
+};
+
+// Привязка текущего потока к логическому CPU (cpu < 0 - не привязывать)
+inline bool pin_current_thread(int cpu) {
+#ifdef __linux__
+    if (cpu < 0) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+// CPU для потока с номером index по заранее вычисленному порядку политики
+inline int placement_cpu(const vector<int>& order, int index) {
+    if (order.empty()) return -1;
+    return order[index % order.size()];
+}
+
+#endif
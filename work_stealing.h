@@ -0,0 +1,167 @@
+#ifndef WORK_STEALING_H
+#define WORK_STEALING_H
+
+#include "worker_pool.h"
+#include "fast_random.h"
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <functional>
+#include <chrono>
+#include <memory>
+#include <algorithm>
+
+using namespace std;
+
+// Планировщик с кражей работы поверх WorkerPool для параллельных проходов по диапазону.
+// У каждого воркера своя очередь диапазонов: свой диапазон он берет спереди кусками по grain,
+// а освободившийся воркер крадет у других половину последнего диапазона сзади.
+// Воркер, которому нечего ни взять, ни украсть, сразу завершается и не крутится вхолостую.
+// Так медленное (занятое чужой нагрузкой) ядро не задерживает весь проход.
+// Очереди живут в синглтоне и переиспользуются между фазами и вызовами
+class WorkStealingScheduler {
+public:
+    // Итоги последнего parallel_for по воркеру
+    struct WorkerStats {
+        long long items = 0;      // обработано элементов
+        long long steals = 0;     // удачных краж
+        double busy_us = 0.0;     // от старта до конца последнего куска
+    };
+
+private:
+    struct Range {
+        size_t begin;
+        size_t end;
+    };
+
+    // Очередь воркера на своей кэш-линии: соседние воркеры не мешают друг другу
+    struct alignas(64) WorkerQueue {
+        mutex mtx;
+        deque<Range> ranges;
+    };
+
+    vector<unique_ptr<WorkerQueue>> queues;
+    vector<WorkerStats> stats;
+
+    WorkStealingScheduler() = default;
+
+    void ensure_queues(int count) {
+        while (static_cast<int>(queues.size()) < count) {
+            queues.push_back(make_unique<WorkerQueue>());
+        }
+    }
+
+    // Кусок своей очереди: спереди, не больше grain
+    bool pop_local(int worker, size_t grain, Range& out) {
+        WorkerQueue& queue = *queues[worker];
+        lock_guard<mutex> lock(queue.mtx);
+        if (queue.ranges.empty()) return false;
+        Range& front = queue.ranges.front();
+        out = {front.begin, min(front.end, front.begin + grain)};
+        front.begin = out.end;
+        if (front.begin == front.end) {
+            queue.ranges.pop_front();
+        }
+        return true;
+    }
+
+    // Кража у victim: последний диапазон целиком, если он не больше grain, иначе его вторая половина
+    bool steal(int victim, size_t grain, Range& out) {
+        WorkerQueue& queue = *queues[victim];
+        lock_guard<mutex> lock(queue.mtx);
+        if (queue.ranges.empty()) return false;
+        Range& back = queue.ranges.back();
+        size_t size = back.end - back.begin;
+        if (size <= grain) {
+            out = back;
+            queue.ranges.pop_back();
+        } else {
+            size_t middle = back.begin + size / 2;
+            out = {middle, back.end};
+            back.end = middle;
+        }
+        return true;
+    }
+
+    void push_local(int worker, Range range) {
+        WorkerQueue& queue = *queues[worker];
+        lock_guard<mutex> lock(queue.mtx);
+        queue.ranges.push_back(range);
+    }
+
+public:
+    WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+    WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+
+    static WorkStealingScheduler& instance() {
+        static WorkStealingScheduler scheduler;
+        return scheduler;
+    }
+
+    // Размер куска по умолчанию: ~32 куска на воркера, но не мельче min_grain
+    static size_t default_grain(size_t total, int num_threads, size_t min_grain = 4096) {
+        return max(min_grain, total / (static_cast<size_t>(max(1, num_threads)) * 32));
+    }
+
+    // Выполняет body(worker, begin, end) по кускам [0, total) на num_threads воркерах пула.
+    // Вначале у каждого воркера свой непрерывный отрезок, как при статическом разбиении.
+    // Вызывается из управляющего потока, как и WorkerPool::run
+    void parallel_for(size_t total, int num_threads, size_t grain,
+                      const function<void(int, size_t, size_t)>& body) {
+        num_threads = max(1, num_threads);
+        grain = max<size_t>(1, grain);
+        ensure_queues(num_threads);
+        stats.assign(num_threads, WorkerStats{});
+
+        size_t chunk = total / num_threads;
+        for (int i = 0; i < num_threads; ++i) {
+            queues[i]->ranges.clear();
+            size_t begin = i * chunk;
+            size_t end = (i == num_threads - 1) ? total : begin + chunk;
+            if (begin < end) {
+                queues[i]->ranges.push_back({begin, end});
+            }
+        }
+
+        WorkerPool::instance().run(num_threads, [&](int worker) {
+            auto started = chrono::steady_clock::now();
+            auto last_chunk_end = started;
+            Xoshiro256 rng = Xoshiro256::for_thread(benchmark_seed(), worker);
+            long long items = 0;
+            long long steals = 0;
+            Range range;
+
+            while (true) {
+                if (pop_local(worker, grain, range)) {
+                    body(worker, range.begin, range.end);
+                    items += range.end - range.begin;
+                    last_chunk_end = chrono::steady_clock::now();
+                    continue;
+                }
+
+                // Своя очередь пуста: обходим остальных со случайного места
+                bool stolen = false;
+                int start = num_threads > 1 ? static_cast<int>(rng.below(num_threads)) : 0;
+                for (int k = 0; k < num_threads && !stolen; ++k) {
+                    int victim = (start + k) % num_threads;
+                    if (victim != worker && steal(victim, grain, range)) {
+                        push_local(worker, range);
+                        steals++;
+                        stolen = true;
+                    }
+                }
+                // Все очереди пусты: остались только куски, которые уже взяты другими воркерами
+                // (украденный диапазон вор кладет к себе и доделывает сам), - выходим, не мешая им
+                if (!stolen) break;
+            }
+
+            stats[worker] = {items, steals, items > 0 ? chrono::duration<double, micro>(
+                last_chunk_end - started).count() : 0.0};
+        });
+    }
+
+    // По воркерам за последний parallel_for
+    const vector<WorkerStats>& last_stats() const { return stats; }
+};
+
+#endif
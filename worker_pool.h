@@ -0,0 +1,200 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include "topology.h"
+#include "perf_counters.h"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <chrono>
+#include <memory>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace std;
+
+// Постоянный пул рабочих потоков для бенчмарков всех заданий.
+// Потоки создаются один раз и засыпают между запусками, поэтому замер не включает
+// создание и join потоков. Каждый run() проходит через стартовые ворота: задания
+// начинаются вместе, а время считается от открытия ворот до конца последнего задания.
+// run() вызывается из одного управляющего потока, задания не должны вызывать run() сами
+class WorkerPool {
+private:
+    struct Worker {
+        thread handle;
+#ifdef __linux__
+        cpu_set_t default_affinity;   // маска при создании, к ней возвращаемся без политики
+#endif
+    };
+
+    vector<unique_ptr<Worker>> workers;
+    mutex mtx;
+    condition_variable work_cv;
+    condition_variable done_cv;
+
+    // Текущий запуск
+    const function<void(int)>* task = nullptr;
+    const vector<int>* cpu_order = nullptr;
+    int active = 0;                   // сколько воркеров участвует
+    long long generation = 0;
+    int remaining = 0;                // под mtx: сколько заданий еще не завершилось
+    bool shutting_down = false;
+
+    atomic<int> ready{0};             // воркеры у стартовых ворот
+    atomic<bool> gate_open{false};
+    chrono::steady_clock::time_point gate_time;
+    chrono::steady_clock::time_point finish_time;
+    double last_run_us = 0.0;
+    PerfSample last_perf;
+
+    WorkerPool() = default;
+
+    static int& worker_index() {
+        static thread_local int index = -1;
+        return index;
+    }
+
+    // Ожидание у ворот: крутимся немного, потом уступаем CPU (ядер может быть меньше потоков)
+    static void wait_gate(const atomic<bool>& flag) {
+        for (unsigned spins = 0; !flag.load(memory_order_acquire); ++spins) {
+            if (spins >= 256) this_thread::yield();
+        }
+    }
+
+    void place(Worker& worker, int index) {
+#ifdef __linux__
+        if (cpu_order != nullptr && !cpu_order->empty()) {
+            pin_current_thread(placement_cpu(*cpu_order, index));
+        } else {
+            pthread_setaffinity_np(pthread_self(), sizeof(worker.default_affinity),
+                                   &worker.default_affinity);
+        }
+#else
+        (void)worker;
+        (void)index;
+#endif
+    }
+
+    void worker_loop(Worker& worker, int index) {
+        long long seen = 0;
+        worker_index() = index;
+        PerfCounters::register_current_thread();
+
+        while (true) {
+            {
+                unique_lock<mutex> lock(mtx);
+                work_cv.wait(lock, [&]() {
+                    return shutting_down || (generation != seen && index < active);
+                });
+                if (shutting_down) return;
+                seen = generation;
+            }
+
+            // Размещение до ворот, чтобы системный вызов не попал в замер
+            place(worker, index);
+            ready.fetch_add(1, memory_order_acq_rel);
+            wait_gate(gate_open);
+
+            (*task)(index);
+
+            lock_guard<mutex> lock(mtx);
+            if (--remaining == 0) {
+                finish_time = chrono::steady_clock::now();
+                done_cv.notify_one();
+            }
+        }
+    }
+
+    void ensure_workers(int count) {
+        while (static_cast<int>(workers.size()) < count) {
+            auto worker = make_unique<Worker>();
+#ifdef __linux__
+            sched_getaffinity(0, sizeof(worker->default_affinity), &worker->default_affinity);
+#endif
+            int index = static_cast<int>(workers.size());
+            Worker& created = *worker;
+            workers.push_back(move(worker));
+            created.handle = thread(&WorkerPool::worker_loop, this, ref(created), index);
+        }
+    }
+
+public:
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    ~WorkerPool() {
+        {
+            lock_guard<mutex> lock(mtx);
+            shutting_down = true;
+        }
+        work_cv.notify_all();
+        for (auto& worker : workers) {
+            worker->handle.join();
+        }
+    }
+
+    static WorkerPool& instance() {
+        static WorkerPool pool;
+        return pool;
+    }
+
+    int size() const { return static_cast<int>(workers.size()); }
+
+    // Номер воркера, на котором выполняется вызывающий код (-1 вне пула).
+    // Задание i всегда выполняет воркер i
+    static int current_worker() { return worker_index(); }
+
+    // Выполняет job(i) для i в [0, num_tasks) на воркерах 0..num_tasks-1 и ждет завершения.
+    // order - порядок CPU политики размещения (пустой - без привязки).
+    // Возвращает время от открытия ворот до конца последнего задания в микросекундах
+    double run(int num_tasks, const function<void(int)>& job, const vector<int>& order = {}) {
+        if (num_tasks <= 0) {
+            last_run_us = 0.0;
+            return last_run_us;
+        }
+
+        {
+            lock_guard<mutex> lock(mtx);
+            ensure_workers(num_tasks);
+            task = &job;
+            cpu_order = &order;
+            active = num_tasks;
+            remaining = num_tasks;
+            ready.store(0, memory_order_relaxed);
+            gate_open.store(false, memory_order_relaxed);
+            generation++;
+        }
+        work_cv.notify_all();
+
+        // Все воркеры на месте - открываем ворота
+        for (unsigned spins = 0; ready.load(memory_order_acquire) < num_tasks; ++spins) {
+            if (spins >= 256) this_thread::yield();
+        }
+        PerfSample perf_before = PerfCounters::snapshot();
+        gate_time = chrono::steady_clock::now();
+        gate_open.store(true, memory_order_release);
+
+        unique_lock<mutex> lock(mtx);
+        done_cv.wait(lock, [&]() { return remaining == 0; });
+        task = nullptr;
+        cpu_order = nullptr;
+        last_perf = PerfCounters::snapshot() - perf_before;
+
+        last_run_us = chrono::duration_cast<chrono::nanoseconds>(finish_time - gate_time).count()
+                      / 1000.0;
+        return last_run_us;
+    }
+
+    // Время последнего run() (только конкурентная часть)
+    double last_run_microseconds() const { return last_run_us; }
+
+    // Счетчики perf последнего run() по всем воркерам
+    const PerfSample& last_run_perf() const { return last_perf; }
+};
+
+#endif